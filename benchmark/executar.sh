@@ -0,0 +1,87 @@
+#!/bin/bash
+#---------------- File: executar.sh -----------------------
+# Varredura de tamanhos: gera instancias sinteticas (gerador), roda cada motor
+# de cada problema e junta o registro --stats de cada execucao (tempo por fase
+# e pico de memoria) em $SAIDA, uma linha JSON por execucao.
+#
+# Uso: ./executar.sh [problemas...]            (padrao: pcm pd pd_esparso pfcm pfmax pt)
+# Variaveis: TAMANHOS_<problema>, TIPOS (random grid), SEED, SAIDA, DIR,
+#            THREADS (varredura do pfmax --engine=parallel)
+# pd_esparso e o pd --sparse em instancias proprias (gerador --sparse): N tarefas,
+# N/2 pessoas, cada uma qualificada para 30 tarefas, como numa escala de trabalho.
+# O motor cplex entra quando ../<problema>/main.exe existe (make no problema).
+#-----------------------------------------------------------
+
+cd "$(dirname "$0")"
+
+PROBLEMAS=${@:-pcm pd pd_esparso pfcm pfmax pt}
+TIPOS=${TIPOS:-random grid}
+SEED=${SEED:-1}
+SAIDA=${SAIDA:-resultados.jsonl}
+DIR=${DIR:-instancias}
+THREADS=${THREADS:-1 2 4 8 16 32 64}
+
+TAMANHOS_pcm=${TAMANHOS_pcm:-10000 100000 1000000}
+TAMANHOS_pd=${TAMANHOS_pd:-100 200 400 800}
+TAMANHOS_pd_esparso=${TAMANHOS_pd_esparso:-10000 100000}
+TAMANHOS_pfcm=${TAMANHOS_pfcm:-1000 10000 100000}
+TAMANHOS_pfmax=${TAMANHOS_pfmax:-10000 100000 1000000}
+TAMANHOS_pt=${TAMANHOS_pt:-100 200 400 800 1600}
+
+#Variantes de cada problema (argumentos do executavel nativo)
+VARIANTES_pcm=("--engine=native --heap=binary" "--engine=native --heap=radix" "--engine=native --bidirectional")
+VARIANTES_pd=("--engine=native" "--engine=auction")
+VARIANTES_pd_esparso=("--engine=native --sparse")
+VARIANTES_pfcm=("--engine=native")
+VARIANTES_pfmax=("--engine=native")
+for t in $THREADS; do VARIANTES_pfmax+=("--engine=parallel --threads=$t"); done
+VARIANTES_pt=("--engine=native")
+
+#Executavel, argumentos do gerador (o N da varredura vem em --size) e variante do cplex de cada problema
+programa(){ echo "${1%_esparso}"; }
+gerador(){
+	case $1 in
+		pd_esparso) echo "--problem=pd --sparse --degree=30 --rows=$(($2 / 2))" ;;
+		*) echo "--problem=$1" ;;
+	esac
+}
+cplex(){
+	case $1 in
+		pd_esparso) echo "--engine=cplex --sparse" ;;
+		*) echo "--engine=cplex" ;;
+	esac
+}
+
+mkdir -p "$DIR"
+STATS=$(mktemp)
+trap 'rm -f "$STATS"' EXIT
+
+for p in $PROBLEMAS; do
+	tamanhos=TAMANHOS_$p
+	variantes="VARIANTES_$p[@]"
+	exe=$(programa $p)
+	for tipo in $TIPOS; do
+		for n in ${!tamanhos}; do
+			inst="$DIR/${p}_${tipo}_${n}.txt"
+			[ -f "$inst" ] || ../gerador/gerador.exe $(gerador $p $n) --kind=$tipo --size=$n --seed=$SEED > "$inst"
+
+			execucoes=()
+			for v in "${!variantes}"; do execucoes+=("../$exe/main_nativo.exe $v"); done
+			[ -x "../$exe/main.exe" ] && execucoes+=("../$exe/main.exe $(cplex $p)")
+
+			for cmd in "${execucoes[@]}"; do
+				: > "$STATS"
+				ini=$(date +%s%N)
+				$cmd --quiet --stats="$STATS" "$inst" > /dev/null
+				fim=$(date +%s%N)
+				variante=${cmd#*.exe }
+				#Prefixa o registro do solver com problema, tipo, tamanho, variante e tempo total
+				sed "s|^{|{\"problema\":\"$p\",\"tipo\":\"$tipo\",\"tamanho\":$n,\"variante\":\"$variante\",\"total_ns\":$((fim - ini)),|" "$STATS" >> "$SAIDA"
+				awk -v p=$p -v t=$tipo -v n=$n -v v="$variante" -v total=$((fim - ini)) '
+					match($0, /"resolucao_ns":[0-9]+/){ r = substr($0, RSTART + 15, RLENGTH - 15) }
+					match($0, /"pico_rss_bytes":[0-9]+/){ m = substr($0, RSTART + 17, RLENGTH - 17) }
+					END { printf "%-10s %-7s %9d  %-34s total %9.3f s  resolucao %9.3f s  pico %8.1f MB\n", p, t, n, v, total / 1e9, r / 1e9, m / 1048576 }' "$STATS"
+			done
+		done
+	done
+done
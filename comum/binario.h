@@ -0,0 +1,184 @@
+/*---------------- File: binario.h  ---------------------+
+|Formato binario de instancias (mapeado com mmap)        |
+|					      		                        |
+| Cabecalho fixo, os inteiros do cabecalho do in.txt e   |
+| as colunas do Grafo ja comprimidas (CSR). Os solvers   |
+| usam o arquivo mapeado sem copiar nem interpretar os   |
+| arcos. Gerado a partir do in.txt pelo conversor.       |
++-------------------------------------------------------+ */
+
+#ifndef BINARIO_H
+#define BINARIO_H
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "grafo.h"
+
+using namespace std;
+
+//Secoes do arquivo, todas de int32 e alinhadas em 64 bytes
+enum SecaoBinaria { PREFIXO, INICIO, ORIGEM, DESTINO, INICIO_INV, ARCO_INV, CUSTO, CAP, N_SECOES };
+
+struct CabecalhoBinario {
+	static constexpr char MAGICA[8] = {'P', 'O', 'G', 'R', 'A', 'F', 'O', '1'};
+
+	char magica[8];
+	char problema[8];	//pcm, pd, pfcm, pfmax ou pt
+	int64_t n, nDest, m;	//como no Grafo
+	int64_t nPrefixo;	//inteiros antes dos arcos no in.txt (quantidades, ofertas, demandas...)
+	int64_t nRotas;	//linhas de arco lidas, repeticoes incluidas
+	int64_t secao[N_SECOES];	//deslocamento de cada secao no arquivo
+
+	//Quantidade de inteiros de cada secao
+	int64_t tamanho(int s) const {
+		if(s == PREFIXO) return nPrefixo;
+		if(s == INICIO) return n + 1;
+		if(s == INICIO_INV) return nDest + 1;
+		return m;
+	}
+};
+
+//Grava a instancia ja montada em g
+inline bool gravarBinario(const string& caminho, const string& problema, const vector<int>& prefixo, long long nRotas, const Grafo& g){
+	CabecalhoBinario cab;
+	const int* dados[N_SECOES] = { prefixo.data(), g.inicio.data(), g.origem.data(), g.destino.data(),
+		g.inicioInv.data(), g.arcoInv.data(), g.custo.data(), g.cap.data() };
+	int64_t pos;
+	static const char zeros[64] = {};
+
+	memset(&cab, 0, sizeof(cab));
+	memcpy(cab.magica, CabecalhoBinario::MAGICA, 8);
+	strncpy(cab.problema, problema.c_str(), 7);
+	cab.n = g.n;
+	cab.nDest = g.nDest;
+	cab.m = g.m;
+	cab.nPrefixo = prefixo.size();
+	cab.nRotas = nRotas;
+	pos = sizeof(cab);
+	for( int s = 0; s < N_SECOES; s++ ){
+		pos = (pos + 63) / 64 * 64;
+		cab.secao[s] = pos;
+		pos += cab.tamanho(s) * (int64_t)sizeof(int);
+	}
+
+	FILE* f = fopen(caminho.c_str(), "wb");
+	if(f == nullptr) return false;
+	bool ok = fwrite(&cab, sizeof(cab), 1, f) == 1;
+	pos = sizeof(cab);
+	for( int s = 0; s < N_SECOES && ok; s++ ){
+		if(cab.secao[s] > pos) ok = fwrite(zeros, 1, cab.secao[s] - pos, f) == (size_t)(cab.secao[s] - pos);
+		if(ok && cab.tamanho(s) > 0) ok = fwrite(dados[s], sizeof(int), cab.tamanho(s), f) == (size_t)cab.tamanho(s);
+		pos = cab.secao[s] + cab.tamanho(s) * (int64_t)sizeof(int);
+	}
+	return fclose(f) == 0 && ok;
+}
+
+//Instancia binaria mapeada. O mapeamento e privado: alterar o Grafo (ex.: capacidades)
+//nao muda o arquivo. Fica valido ate a proxima abrir() ou fechar().
+struct InstanciaBinaria {
+	char* base = nullptr;
+	size_t tam = 0;
+	const CabecalhoBinario* cab = nullptr;
+	bool corrompido = false;	//a ultima abrir() achou um binario e o recusou (nao e texto)
+
+	~InstanciaBinaria(){ fechar(); }
+
+	void fechar(){
+		if(base != nullptr) munmap(base, tam);
+		base = nullptr;
+		tam = 0;
+		cab = nullptr;
+	}
+
+	//Mapeia o arquivo se ele estiver no formato binario. Nao consome nada de quem
+	//le o mesmo arquivo como texto (o arquivo e aberto de novo).
+	bool abrir(const string& caminho){
+		struct stat st;
+		char magica[8];
+		int fd;
+
+		fechar();
+		corrompido = false;
+		if(caminho.empty() || (fd = open(caminho.c_str(), O_RDONLY)) < 0) return false;
+		if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < (off_t)sizeof(CabecalhoBinario)
+		   || pread(fd, magica, 8, 0) != 8 || memcmp(magica, CabecalhoBinario::MAGICA, 8) != 0){
+			close(fd);
+			return false;
+		}
+		void* p = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if(p == MAP_FAILED){
+			fprintf(stderr, "Nao foi possivel mapear %s\n", caminho.c_str());
+			corrompido = true;
+			return false;
+		}
+		base = (char*)p;
+		tam = st.st_size;
+		cab = (const CabecalhoBinario*)base;
+		if(!consistente()){
+			fprintf(stderr, "Arquivo binario %s truncado ou corrompido\n", caminho.c_str());
+			fechar();
+			corrompido = true;
+			return false;
+		}
+		madvise(base, tam, MADV_WILLNEED);
+		return true;
+	}
+
+	//Secoes dentro do arquivo e colunas CSR coerentes com o cabecalho: um arquivo corrompido
+	//e recusado aqui em vez de derrubar o solver
+	bool consistente() const {
+		const int64_t LIMITE = INT_MAX - 1;
+		int64_t s, k;
+
+		if(cab->n < 0 || cab->n > LIMITE || cab->nDest < 0 || cab->nDest > LIMITE || cab->m < 0 || cab->m > LIMITE
+		   || cab->nPrefixo < 0 || cab->nPrefixo > LIMITE) return false;
+		for( s = 0; s < N_SECOES; s++ ){
+			//Sem overflow: o deslocamento vem antes, e o tamanho e comparado com o que sobra
+			if(cab->secao[s] < (int64_t)sizeof(CabecalhoBinario) || cab->secao[s] % 64 != 0 || cab->secao[s] > (int64_t)tam
+			   || cab->tamanho(s) > ((int64_t)tam - cab->secao[s]) / (int64_t)sizeof(int)) return false;
+		}
+
+		const int *ini = secao(INICIO), *ori = secao(ORIGEM), *dst = secao(DESTINO);
+		const int *iniInv = secao(INICIO_INV), *inv = secao(ARCO_INV);
+		if(ini[0] != 0 || ini[cab->n] != cab->m || iniInv[0] != 0 || iniInv[cab->nDest] != cab->m) return false;
+		for( k = 0; k < cab->n; k++ ) if(ini[k] > ini[k + 1]) return false;
+		for( k = 0; k < cab->nDest; k++ ) if(iniInv[k] > iniInv[k + 1]) return false;
+		for( k = 0; k < cab->m; k++ ){
+			if(ori[k] < 0 || ori[k] >= cab->n || dst[k] < 0 || dst[k] >= cab->nDest || inv[k] < 0 || inv[k] >= cab->m) return false;
+		}
+		return true;
+	}
+
+	//O grafo do arquivo tem o tamanho que o prefixo indica (n vertices de saida, nDest de chegada)
+	bool dimensoes(int64_t n, int64_t nDest) const {
+		if(cab->n == n && cab->nDest == nDest) return true;
+		fprintf(stderr, "Arquivo binario corrompido: o grafo tem %lld x %lld vertices e o prefixo indica %lld x %lld\n",
+			(long long)cab->n, (long long)cab->nDest, (long long)n, (long long)nDest);
+		return false;
+	}
+
+	string problema() const { return string(cab->problema, strnlen(cab->problema, 8)); }
+
+	int* secao(int s) const { return (int*)(base + cab->secao[s]); }
+	const int* prefixo() const { return secao(PREFIXO); }
+
+	//Aponta as colunas do grafo para o arquivo, sem copiar
+	void vista(Grafo& g) const {
+		g.n = cab->n;
+		g.nDest = cab->nDest;
+		g.m = cab->m;
+		g.inicio.apontar(secao(INICIO), cab->n + 1);
+		g.origem.apontar(secao(ORIGEM), cab->m);
+		g.destino.apontar(secao(DESTINO), cab->m);
+		g.inicioInv.apontar(secao(INICIO_INV), cab->nDest + 1);
+		g.arcoInv.apontar(secao(ARCO_INV), cab->m);
+		g.custo.apontar(secao(CUSTO), cab->m);
+		g.cap.apontar(secao(CAP), cab->m);
+	}
+};
+
+#endif
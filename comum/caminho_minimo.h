@@ -0,0 +1,270 @@
+/*---------------- File: caminho_minimo.h  --------------+
+|Caminho Minimo - Dijkstra                               |
+|					      		                        |
+| Heap binario ou radix heap (custos inteiros nao        |
+| negativos), busca unidirecional ou bidirecional        |
+| (estrela direta a partir da origem, reversa a partir   |
+| do destino).                                           |
++-------------------------------------------------------+ */
+
+#ifndef CAMINHO_MINIMO_H
+#define CAMINHO_MINIMO_H
+
+#include <bits/stdc++.h>
+#include "grafo.h"
+
+using namespace std;
+
+//Heap binario com remocao preguicosa (entradas antigas sao descartadas por quem usa)
+struct HeapBinario {
+	priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> fila;
+
+	void push(long long chave, int v){ fila.push(make_pair(chave, v)); }
+	bool empty() const { return fila.empty(); }
+	pair<long long, int> topo(){ return fila.top(); }
+	pair<long long, int> pop(){
+		pair<long long, int> r = fila.top();
+		fila.pop();
+		return r;
+	}
+	void clear(){ fila = decltype(fila)(); }
+};
+
+//Radix heap monotono: as chaves inseridas nunca sao menores que a ultima removida
+struct HeapRadix {
+	vector<pair<long long, int>> balde[65];
+	unsigned long long ultimo = 0;
+	size_t tam = 0;
+
+	int indice(unsigned long long chave) const {
+		return chave == ultimo ? 0 : 64 - __builtin_clzll(chave ^ ultimo);
+	}
+	void push(long long chave, int v){
+		balde[indice(chave)].push_back(make_pair(chave, v));
+		tam++;
+	}
+	bool empty() const { return tam == 0; }
+
+	//Redistribui o primeiro balde nao vazio quando o balde 0 esta vazio
+	void preparar(){
+		if(!balde[0].empty()) return;
+		int b = 1;
+		while(balde[b].empty()) b++;
+		unsigned long long menor = ULLONG_MAX;
+		for( auto& e : balde[b] ) menor = min(menor, (unsigned long long)e.first);
+		ultimo = menor;
+		for( auto& e : balde[b] ) balde[indice(e.first)].push_back(e);
+		balde[b].clear();
+	}
+	pair<long long, int> topo(){
+		preparar();
+		return balde[0].back();
+	}
+	pair<long long, int> pop(){
+		preparar();
+		pair<long long, int> r = balde[0].back();
+		balde[0].pop_back();
+		tam--;
+		return r;
+	}
+	void clear(){
+		for( int b = 0; b < 65; b++ ) balde[b].clear();
+		ultimo = 0;
+		tam = 0;
+	}
+};
+
+struct CaminhoMinimo {
+	static constexpr long long INF = numeric_limits<long long>::max() / 4;
+
+	const Grafo* g;
+	vector<long long> distF, distB;	//distancias a partir da origem / ate o destino
+	vector<int> predF, predB;	//arco usado para chegar em cada vertice em cada direcao
+	vector<char> fechadoF, fechadoB;
+	vector<int> tocadasF, tocadasB;	//vertices com distancia finita em cada direcao (so eles voltam ao inicio)
+	int encontro = -1;	//vertice onde as buscas se encontram
+	long long nFechados = 0;
+
+	//Dijkstra exige custos nao negativos
+	static bool custosValidos(const Grafo& grafo){
+		for( int k = 0; k < grafo.m; k++ ) if(grafo.custo[k] < 0) return false;
+		return true;
+	}
+
+	//Volta os vetores ao estado inicial. So os vertices tocados pela busca anterior sao limpos:
+	//varias buscas curtas no mesmo grafo nao pagam O(n) cada. Os vetores da busca reversa so
+	//existem depois da primeira busca bidirecional.
+	static void reiniciar(const Grafo& grafo, vector<long long>& dist, vector<int>& pred, vector<char>& fechado, vector<int>& tocadas, bool alocar){
+		if(dist.size() != (size_t)grafo.n){
+			if(!alocar && dist.empty()) return;
+			dist.assign(grafo.n, INF);
+			pred.assign(grafo.n, -1);
+			fechado.assign(grafo.n, 0);
+			tocadas.clear();
+			return;
+		}
+		for( int v : tocadas ){
+			dist[v] = INF;
+			pred[v] = -1;
+			fechado[v] = 0;
+		}
+		tocadas.clear();
+	}
+
+	void preparar(const Grafo& grafo, bool reversa){
+		g = &grafo;
+		reiniciar(grafo, distF, predF, fechadoF, tocadasF, true);
+		reiniciar(grafo, distB, predB, fechadoB, tocadasB, reversa);
+		encontro = -1;
+		nFechados = 0;
+	}
+
+	//Dijkstra da origem s; para logo depois de fechar um vertice u com parar(u) verdadeiro
+	template<class Heap, class Parar>
+	void busca(const Grafo& grafo, int s, Parar parar){
+		int u, v, k;
+		long long nd;
+		Heap heap;
+
+		preparar(grafo, false);
+		distF[s] = 0;
+		tocadasF.push_back(s);
+		heap.push(0, s);
+		while(!heap.empty()){
+			pair<long long, int> topo = heap.pop();
+			u = topo.second;
+			if(fechadoF[u] || topo.first != distF[u]) continue;
+			fechadoF[u] = 1;
+			nFechados++;
+			if(parar(u)) break;
+			for( k = grafo.inicio[u]; k < grafo.inicio[u + 1]; k++ ){
+				v = grafo.destino[k];
+				nd = distF[u] + grafo.custo[k];
+				if(nd < distF[v]){
+					if(distF[v] == INF) tocadasF.push_back(v);
+					distF[v] = nd;
+					predF[v] = k;
+					heap.push(nd, v);
+				}
+			}
+		}
+	}
+
+	//Dijkstra da origem s, parando ao fechar t (t = -1 calcula todas as distancias)
+	template<class Heap>
+	long long dijkstra(const Grafo& grafo, int s, int t){
+		busca<Heap>(grafo, s, [t](int u){ return u == t; });
+		if(t >= 0 && distF[t] < INF) encontro = t;
+		return t >= 0 ? distF[t] : 0;
+	}
+
+	//Um Dijkstra para varios destinos: para quando todos os marcados em alvo estao fechados
+	//(quantos = total de marcados; 0 calcula todas as distancias)
+	template<class Heap>
+	void dijkstraAlvos(const Grafo& grafo, int s, const vector<char>& alvo, int quantos){
+		busca<Heap>(grafo, s, [&](int u){ return quantos > 0 && alvo[u] && --quantos == 0; });
+	}
+
+	//Remove do topo entradas ja fechadas ou desatualizadas
+	template<class Heap>
+	static void limpar(Heap& heap, const vector<long long>& dist, const vector<char>& fechado){
+		while(!heap.empty()){
+			pair<long long, int> topo = heap.topo();
+			if(!fechado[topo.second] && topo.first == dist[topo.second]) return;
+			heap.pop();
+		}
+	}
+
+	//Busca bidirecional: para quando topo(frente) + topo(tras) >= melhor caminho visto
+	template<class Heap>
+	long long bidirecional(const Grafo& grafo, int s, int t){
+		int u, v, k, p;
+		long long nd, melhor = INF;
+		Heap frente, tras;
+
+		preparar(grafo, true);
+		distF[s] = 0;
+		distB[t] = 0;
+		tocadasF.push_back(s);
+		tocadasB.push_back(t);
+		frente.push(0, s);
+		tras.push(0, t);
+		if(s == t){
+			encontro = s;
+			return 0;
+		}
+
+		while(true){
+			limpar(frente, distF, fechadoF);
+			limpar(tras, distB, fechadoB);
+			if(frente.empty() || tras.empty()) break;
+			long long topoF = frente.topo().first, topoB = tras.topo().first;
+			if(topoF + topoB >= melhor) break;
+
+			if(topoF <= topoB){
+				u = frente.pop().second;
+				fechadoF[u] = 1;
+				nFechados++;
+				for( k = grafo.inicio[u]; k < grafo.inicio[u + 1]; k++ ){
+					v = grafo.destino[k];
+					nd = distF[u] + grafo.custo[k];
+					if(nd < distF[v]){
+						if(distF[v] == INF) tocadasF.push_back(v);
+						distF[v] = nd;
+						predF[v] = k;
+						frente.push(nd, v);
+					}
+					if(distB[v] < INF && nd + distB[v] < melhor){
+						melhor = nd + distB[v];
+						encontro = v;
+					}
+				}
+			}else{
+				u = tras.pop().second;
+				fechadoB[u] = 1;
+				nFechados++;
+				for( p = grafo.inicioInv[u]; p < grafo.inicioInv[u + 1]; p++ ){
+					k = grafo.arcoInv[p];
+					v = grafo.origem[k];
+					nd = distB[u] + grafo.custo[k];
+					if(nd < distB[v]){
+						if(distB[v] == INF) tocadasB.push_back(v);
+						distB[v] = nd;
+						predB[v] = k;
+						tras.push(nd, v);
+					}
+					if(distF[v] < INF && distF[v] + nd < melhor){
+						melhor = distF[v] + nd;
+						encontro = v;
+					}
+				}
+			}
+		}
+		return melhor;
+	}
+
+	//Vertices do caminho da origem da ultima busca unidirecional ate t (vazio se inalcancavel)
+	vector<int> vertices(int t) const {
+		vector<int> vs;
+		if(distF[t] >= INF) return vs;
+		for( int v = t; ; v = g->origem[predF[v]] ){
+			vs.push_back(v);
+			if(predF[v] < 0) break;
+		}
+		reverse(vs.begin(), vs.end());
+		return vs;
+	}
+
+	//Arcos do caminho encontrado, em ordem de indice (ordem (i, j) do grafo)
+	vector<int> caminho() const {
+		vector<int> arcos;
+		int v;
+		if(encontro < 0) return arcos;
+		for( v = encontro; predF[v] >= 0; v = g->origem[predF[v]] ) arcos.push_back(predF[v]);
+		if(!predB.empty()) for( v = encontro; predB[v] >= 0; v = g->destino[predB[v]] ) arcos.push_back(predB[v]);
+		sort(arcos.begin(), arcos.end());
+		return arcos;
+	}
+};
+
+#endif
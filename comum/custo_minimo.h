@@ -0,0 +1,382 @@
+/*---------------- File: custo_minimo.h  ----------------+
+|Fluxo de Custo Minimo - Simplex de Redes                |
+|					      		                        |
+| Simplex primal sobre arvore geradora fortemente        |
+| viavel (raiz artificial), com listas thread/rev_thread |
+| e busca do arco de entrada em blocos.                  |
++-------------------------------------------------------+ */
+
+#ifndef CUSTO_MINIMO_H
+#define CUSTO_MINIMO_H
+
+#include <bits/stdc++.h>
+
+using namespace std;
+
+struct CustoMinimo {
+	enum Status { OTIMO, INVIAVEL, ILIMITADO, INTERROMPIDO };
+
+	static constexpr long long INF = numeric_limits<long long>::max();
+	static constexpr int ESTADO_SUPERIOR = -1, ESTADO_ARVORE = 0, ESTADO_INFERIOR = 1;
+	static constexpr int DIR_CIMA = 1, DIR_BAIXO = -1;
+
+	//Dados do problema (arcos com limite inferior 0)
+	int n = 0, m = 0;
+	vector<int> origem, destino;
+	vector<long long> cap, custo, oferta;
+
+	//Resultado
+	vector<long long> fluxo, pi;
+	long long nPivos = 0;
+
+	//Cancelamento cooperativo (corrida de motores): consultado a cada 1024 pivos
+	const atomic<bool>* parar = nullptr;
+
+	//Arvore geradora: a raiz e o vertice n, ligado a todos por arcos artificiais m..m+n-1
+	int raiz, totalArcos, tamBloco, proxArco;
+	long long custoArt = 0;	//custo dos arcos artificiais que entram nas demandas
+	vector<int> pai, pred, dirPred, thread, revThread, nSuc, ultSuc, estado, sujos;
+	int arcoEnt, juncao, uEnt, vEnt, uSai, vSai;
+	long long delta;
+
+	int addNo(long long b){
+		oferta.push_back(b);
+		return n++;
+	}
+
+	int addArco(int o, int d, long long c, long long w){
+		origem.push_back(o);
+		destino.push_back(d);
+		cap.push_back(c);
+		custo.push_back(w);
+		return m++;
+	}
+
+	//Custo da solucao (apenas arcos do problema)
+	long long custoTotal() const {
+		long long total = 0;
+		for( int e = 0; e < m; e++ ) total += custo[e] * fluxo[e];
+		return total;
+	}
+
+	void inicializar(){
+		int u, e;
+		long long maxCusto = 0;
+
+		raiz = n;
+		totalArcos = m + n;
+		origem.resize(totalArcos);
+		destino.resize(totalArcos);
+		cap.resize(totalArcos);
+		custo.resize(totalArcos);
+		fluxo.assign(totalArcos, 0);
+		estado.assign(totalArcos, ESTADO_INFERIOR);
+		pi.assign(n + 1, 0);
+		pai.assign(n + 1, -1);
+		pred.assign(n + 1, -1);
+		dirPred.assign(n + 1, 0);
+		thread.assign(n + 1, 0);
+		revThread.assign(n + 1, 0);
+		nSuc.assign(n + 1, 0);
+		ultSuc.assign(n + 1, 0);
+
+		for( e = 0; e < m; e++ ) maxCusto = max(maxCusto, llabs(custo[e]));
+		custoArt = (maxCusto + 1) * (n + 1);
+
+		pai[raiz] = -1;
+		pred[raiz] = -1;
+		thread[raiz] = 0;
+		revThread[0] = raiz;
+		nSuc[raiz] = n + 1;
+		ultSuc[raiz] = raiz - 1;
+		pi[raiz] = 0;
+
+		for( u = 0, e = m; u < n; u++, e++ ){
+			pai[u] = raiz;
+			pred[u] = e;
+			thread[u] = u + 1;
+			revThread[u + 1] = u;
+			nSuc[u] = 1;
+			ultSuc[u] = u;
+			cap[e] = INF;
+			estado[e] = ESTADO_ARVORE;
+			if(oferta[u] >= 0){
+				dirPred[u] = DIR_CIMA;
+				pi[u] = 0;
+				origem[e] = u;
+				destino[e] = raiz;
+				fluxo[e] = oferta[u];
+				custo[e] = 0;
+			}else{
+				dirPred[u] = DIR_BAIXO;
+				pi[u] = custoArt;
+				origem[e] = raiz;
+				destino[e] = u;
+				fluxo[e] = -oferta[u];
+				custo[e] = custoArt;
+			}
+		}
+
+		tamBloco = max((int)sqrt((double)m), 10);
+		proxArco = 0;
+	}
+
+	//Busca em blocos: o arco de menor custo reduzido do primeiro bloco que tiver algum negativo
+	bool arcoEntrada(){
+		long long c, menor = 0;
+		int cont = tamBloco, e;
+
+		for( e = proxArco; e < m; e++ ){
+			c = estado[e] * (custo[e] + pi[origem[e]] - pi[destino[e]]);
+			if(c < menor){
+				menor = c;
+				arcoEnt = e;
+			}
+			if(--cont == 0){
+				if(menor < 0) goto fim;
+				cont = tamBloco;
+			}
+		}
+		for( e = 0; e < proxArco; e++ ){
+			c = estado[e] * (custo[e] + pi[origem[e]] - pi[destino[e]]);
+			if(c < menor){
+				menor = c;
+				arcoEnt = e;
+			}
+			if(--cont == 0){
+				if(menor < 0) goto fim;
+				cont = tamBloco;
+			}
+		}
+		if(menor >= 0) return false;
+
+	fim:
+		proxArco = e;
+		return true;
+	}
+
+	void verticeJuncao(){
+		int u = origem[arcoEnt], v = destino[arcoEnt];
+		while(u != v){
+			if(nSuc[u] < nSuc[v]) u = pai[u];
+			else v = pai[v];
+		}
+		juncao = u;
+	}
+
+	//Retorna false se o proprio arco de entrada limita o ciclo (so troca de limite)
+	bool arcoSaida(){
+		int primeiro, segundo, u, e, res = 0;
+		long long d;
+
+		if(estado[arcoEnt] == ESTADO_INFERIOR){
+			primeiro = origem[arcoEnt];
+			segundo = destino[arcoEnt];
+		}else{
+			primeiro = destino[arcoEnt];
+			segundo = origem[arcoEnt];
+		}
+		delta = cap[arcoEnt];
+
+		for( u = primeiro; u != juncao; u = pai[u] ){
+			e = pred[u];
+			d = fluxo[e];
+			if(dirPred[u] == DIR_BAIXO) d = cap[e] == INF ? INF : cap[e] - d;
+			if(d < delta){
+				delta = d;
+				uSai = u;
+				res = 1;
+			}
+		}
+		for( u = segundo; u != juncao; u = pai[u] ){
+			e = pred[u];
+			d = fluxo[e];
+			if(dirPred[u] == DIR_CIMA) d = cap[e] == INF ? INF : cap[e] - d;
+			if(d <= delta){
+				delta = d;
+				uSai = u;
+				res = 2;
+			}
+		}
+
+		if(res == 1){
+			uEnt = primeiro;
+			vEnt = segundo;
+		}else{
+			uEnt = segundo;
+			vEnt = primeiro;
+		}
+		return res != 0;
+	}
+
+	void alterarFluxo(bool troca){
+		int u;
+		if(delta > 0){
+			long long val = estado[arcoEnt] * delta;
+			fluxo[arcoEnt] += val;
+			for( u = origem[arcoEnt]; u != juncao; u = pai[u] ) fluxo[pred[u]] -= dirPred[u] * val;
+			for( u = destino[arcoEnt]; u != juncao; u = pai[u] ) fluxo[pred[u]] += dirPred[u] * val;
+		}
+		if(troca){
+			estado[arcoEnt] = ESTADO_ARVORE;
+			estado[pred[uSai]] = (fluxo[pred[uSai]] == 0) ? ESTADO_INFERIOR : ESTADO_SUPERIOR;
+		}else{
+			estado[arcoEnt] = -estado[arcoEnt];
+		}
+	}
+
+	void atualizarArvore(){
+		int u, p;
+		int antRevThread = revThread[uSai];
+		int antNSuc = nSuc[uSai];
+		int antUltSuc = ultSuc[uSai];
+		vSai = pai[uSai];
+
+		if(uEnt == uSai){
+			pai[uEnt] = vEnt;
+			pred[uEnt] = arcoEnt;
+			dirPred[uEnt] = uEnt == origem[arcoEnt] ? DIR_CIMA : DIR_BAIXO;
+
+			if(thread[vEnt] != uSai){
+				int depois = thread[antUltSuc];
+				thread[antRevThread] = depois;
+				revThread[depois] = antRevThread;
+				depois = thread[vEnt];
+				thread[vEnt] = uSai;
+				revThread[uSai] = vEnt;
+				thread[antUltSuc] = depois;
+				revThread[depois] = antUltSuc;
+			}
+		}else{
+			int continua = antRevThread == vEnt ? thread[antUltSuc] : thread[vEnt];
+
+			//Percorre o caule de uEnt ate uSai invertendo os pais
+			int caule = uEnt, paiCaule = vEnt, proxCaule;
+			int ultimo = ultSuc[uEnt];
+			int antes, depois = thread[ultimo];
+			thread[vEnt] = uEnt;
+			sujos.clear();
+			sujos.push_back(vEnt);
+			while(caule != uSai){
+				proxCaule = pai[caule];
+				thread[ultimo] = proxCaule;
+				sujos.push_back(ultimo);
+
+				antes = revThread[caule];
+				thread[antes] = depois;
+				revThread[depois] = antes;
+
+				pai[caule] = paiCaule;
+				paiCaule = caule;
+				caule = proxCaule;
+
+				ultimo = ultSuc[caule] == ultSuc[paiCaule] ? revThread[paiCaule] : ultSuc[caule];
+				depois = thread[ultimo];
+			}
+			pai[uSai] = paiCaule;
+			thread[ultimo] = continua;
+			revThread[continua] = ultimo;
+			ultSuc[uSai] = ultimo;
+
+			if(antRevThread != vEnt){
+				thread[antRevThread] = depois;
+				revThread[depois] = antRevThread;
+			}
+
+			for( size_t i = 0; i < sujos.size(); i++ ){
+				u = sujos[i];
+				revThread[thread[u]] = u;
+			}
+
+			int somaSuc = 0, ult = ultSuc[uSai];
+			for( u = uSai, p = pai[u]; u != uEnt; u = p, p = pai[u] ){
+				pred[u] = pred[p];
+				dirPred[u] = -dirPred[p];
+				somaSuc += nSuc[u] - nSuc[p];
+				nSuc[u] = somaSuc;
+				ultSuc[p] = ult;
+			}
+			pred[uEnt] = arcoEnt;
+			dirPred[uEnt] = uEnt == origem[arcoEnt] ? DIR_CIMA : DIR_BAIXO;
+			nSuc[uEnt] = antNSuc;
+		}
+
+		//ultSuc de vEnt e de vSai em direcao a raiz
+		int limite = ultSuc[juncao] == vEnt ? juncao : -1;
+		int ultSai = ultSuc[uSai];
+		for( u = vEnt; u != -1 && ultSuc[u] == vEnt; u = pai[u] ) ultSuc[u] = ultSai;
+
+		if(juncao != antRevThread && vEnt != antRevThread){
+			for( u = vSai; u != limite && ultSuc[u] == antUltSuc; u = pai[u] ) ultSuc[u] = antRevThread;
+		}else if(ultSai != antUltSuc){
+			for( u = vSai; u != limite && ultSuc[u] == antUltSuc; u = pai[u] ) ultSuc[u] = ultSai;
+		}
+
+		for( u = vEnt; u != juncao; u = pai[u] ) nSuc[u] += antNSuc;
+		for( u = vSai; u != juncao; u = pai[u] ) nSuc[u] -= antNSuc;
+	}
+
+	//Desloca os potenciais da subarvore pendurada em uEnt
+	void atualizarPotencial(){
+		long long sigma = pi[vEnt] - pi[uEnt] - dirPred[uEnt] * custo[arcoEnt];
+		int fim = thread[ultSuc[uEnt]];
+		for( int u = uEnt; u != fim; u = thread[u] ) pi[u] += sigma;
+	}
+
+	Status pivotar(){
+		while(arcoEntrada()){
+			verticeJuncao();
+			bool troca = arcoSaida();
+			if(delta == INF) return ILIMITADO;
+			alterarFluxo(troca);
+			if(troca){
+				atualizarArvore();
+				atualizarPotencial();
+			}
+			nPivos++;
+			if((nPivos & 1023) == 0 && parar != nullptr && parar->load(memory_order_relaxed)) return INTERROMPIDO;
+		}
+		//Fluxo restante em arco artificial: ofertas e demandas nao se equilibram
+		for( int e = m; e < totalArcos; e++ ){
+			if(fluxo[e] != 0) return INVIAVEL;
+		}
+		return OTIMO;
+	}
+
+	//Ofertas devem somar zero (oferta > 0 envia, oferta < 0 recebe)
+	Status resolver(){
+		long long soma = 0;
+		for( int u = 0; u < n; u++ ) soma += oferta[u];
+		if(soma != 0) return INVIAVEL;
+
+		inicializar();
+		return pivotar();
+	}
+
+	//Troca capacidade e custo do arco e depois de resolver(), mantendo a arvore atual.
+	//Devolve false quando a base deixa de ser viavel (arco no limite superior que mudou de
+	//capacidade, arco da arvore acima da nova capacidade); nesse caso e preciso chamar
+	//resolver() de novo.
+	bool alterarArco(int e, long long c, long long w){
+		bool quente = true;
+		if(estado[e] == ESTADO_SUPERIOR && c != cap[e]) quente = false;
+		if(estado[e] == ESTADO_ARVORE && fluxo[e] > c) quente = false;
+		if((llabs(w) + 1) * (n + 1) > custoArt){
+			//O custo artificial acompanha o maior custo; os potenciais sao refeitos em reotimizar()
+			custoArt = (llabs(w) + 1) * (n + 1);
+			for( int a = m; a < totalArcos; a++ ) if(origem[a] == raiz) custo[a] = custoArt;
+		}
+		cap[e] = c;
+		custo[e] = w;
+		return quente;
+	}
+
+	//Continua o simplex a partir da arvore atual depois de alterarArco(): o fluxo continua
+	//viavel, so os potenciais sao refeitos (em ordem de thread, pais antes dos filhos)
+	Status reotimizar(){
+		for( int u = thread[raiz]; u != raiz; u = thread[u] ) pi[u] = pi[pai[u]] - dirPred[u] * custo[pred[u]];
+		return pivotar();
+	}
+};
+
+#endif
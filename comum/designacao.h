@@ -0,0 +1,567 @@
+/*---------------- File: designacao.h  ------------------+
+|Problema da Designacao - Hungaro e Leilao               |
+|					      		                        |
+| Hungaro (Kuhn-Munkres com potenciais), O(n^2 m).       |
+| Leilao de Bertsekas com epsilon-scaling e lances       |
+| calculados em paralelo (Jacobi).                       |
+| Instancias retangulares designam min(O, D) pares.      |
+| Modo esparso: so os pares listados, caminhos mais      |
+| curtos com Dijkstra nos custos reduzidos. Gargalo:     |
+| busca binaria no limiar com Hopcroft-Karp.             |
++-------------------------------------------------------+ */
+
+#ifndef DESIGNACAO_H
+#define DESIGNACAO_H
+
+#include <bits/stdc++.h>
+#include "grafo.h"
+#include "paralelo.h"
+#include "caminho_minimo.h"
+
+using namespace std;
+
+struct Designacao {
+	static constexpr long long INF = numeric_limits<long long>::max() / 4;
+
+	int O = 0, D = 0;	//pessoas e tarefas
+	int n = 0, m = 0;	//linhas e colunas internas (n <= m)
+	bool transposta = false;	//linhas sao as tarefas quando O > D
+	vector<long long> a;	//custo da linha i na coluna j em a[i*m + j]
+	vector<int> col;	//coluna designada a cada linha
+	long long nRodadas = 0;
+
+	//Matriz densa a partir do grafo pessoa -> tarefa (pares ausentes custam 0)
+	void carregar(const Grafo& g){
+		O = g.n;
+		D = g.nDest;
+		transposta = O > D;
+		n = min(O, D);
+		m = max(O, D);
+		a.assign((size_t)n * m, 0);
+		for( int k = 0; k < g.m; k++ ){
+			if(transposta) a[(size_t)g.destino[k] * m + g.origem[k]] = g.custo[k];
+			else a[(size_t)g.origem[k] * m + g.destino[k]] = g.custo[k];
+		}
+	}
+
+	//Tarefa designada a pessoa i (-1 se ficou sem tarefa)
+	vector<int> tarefas() const {
+		vector<int> t(O, -1);
+		for( int i = 0; i < n; i++ ){
+			if(transposta) t[col[i]] = i;
+			else t[i] = col[i];
+		}
+		return t;
+	}
+
+	long long total() const {
+		long long soma = 0;
+		for( int i = 0; i < n; i++ ) soma += a[(size_t)i * m + col[i]];
+		return soma;
+	}
+
+	//Caminhos aumentantes mais curtos com potenciais u (linhas) e v (colunas)
+	long long hungaro(){
+		int i, j, i0, j0, j1;
+		long long delta, cur;
+		vector<long long> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+		vector<int> p(m + 1, 0), caminho(m + 1, 0);
+		vector<char> usado(m + 1);
+
+		for( i = 1; i <= n; i++ ){
+			p[0] = i;
+			j0 = 0;
+			fill(minv.begin(), minv.end(), INF);
+			fill(usado.begin(), usado.end(), 0);
+			do{
+				usado[j0] = 1;
+				i0 = p[j0];
+				delta = INF;
+				j1 = 0;
+				const long long* linha = &a[(size_t)(i0 - 1) * m];
+				for( j = 1; j <= m; j++ ){
+					if(usado[j]) continue;
+					cur = linha[j - 1] - u[i0] - v[j];
+					if(cur < minv[j]){
+						minv[j] = cur;
+						caminho[j] = j0;
+					}
+					if(minv[j] < delta){
+						delta = minv[j];
+						j1 = j;
+					}
+				}
+				for( j = 0; j <= m; j++ ){
+					if(usado[j]){
+						u[p[j]] += delta;
+						v[j] -= delta;
+					}else{
+						minv[j] -= delta;
+					}
+				}
+				j0 = j1;
+			}while(p[j0] != 0);
+			do{
+				j1 = caminho[j0];
+				p[j0] = p[j1];
+				j0 = j1;
+			}while(j0);
+		}
+
+		col.assign(n, -1);
+		for( j = 1; j <= m; j++ ){
+			if(p[j] != 0) col[p[j] - 1] = j - 1;
+		}
+		return total();
+	}
+
+	//Leilao direto sobre a matriz quadrada m x m (linhas n..m-1 sao ficticias, beneficio 0).
+	//Beneficios escalados por (m+1): com epsilon final 1 a designacao e otima.
+	long long leilao(int nThreads){
+		int i, j, r;
+		long long maior = 0, eps;
+		long long escala = m + 1;
+		vector<long long> preco(m, 0), lance(m);
+		vector<int> dono(m), obj(m), vencedor(m), alvo(m);
+		vector<long long> valor(m);
+		vector<int> livres, proximos, tocados;
+		Equipe equipe(nThreads);
+
+		for( size_t k = 0; k < a.size(); k++ ) maior = max(maior, llabs(a[k]));
+		eps = max(1LL, maior * escala / 5);
+
+		while(true){
+			fill(dono.begin(), dono.end(), -1);
+			fill(obj.begin(), obj.end(), -1);
+			fill(vencedor.begin(), vencedor.end(), -1);
+			livres.resize(m);
+			iota(livres.begin(), livres.end(), 0);
+
+			while(!livres.empty()){
+				//Lances de todas as linhas livres com os precos atuais
+				equipe.paraCada(livres.size(), [&](int ini, int fim, int){
+					for( int q = ini; q < fim; q++ ){
+						int lin = livres[q], melhor = 0;
+						long long v1 = -INF, v2 = -INF, b;
+						const long long* linha = lin < n ? &a[(size_t)lin * m] : nullptr;
+						for( int c = 0; c < m; c++ ){
+							b = (linha ? -linha[c] * escala : 0) - preco[c];
+							if(b > v1){
+								v2 = v1;
+								v1 = b;
+								melhor = c;
+							}else if(b > v2){
+								v2 = b;
+							}
+						}
+						alvo[lin] = melhor;
+						valor[lin] = preco[melhor] + (v2 == -INF ? 0 : v1 - v2) + eps;
+					}
+				});
+				nRodadas++;
+
+				//Cada objeto fica com o maior lance
+				tocados.clear();
+				for( r = 0; r < (int)livres.size(); r++ ){
+					i = livres[r];
+					j = alvo[i];
+					if(vencedor[j] < 0){
+						vencedor[j] = i;
+						lance[j] = valor[i];
+						tocados.push_back(j);
+					}else if(valor[i] > lance[j]){
+						vencedor[j] = i;
+						lance[j] = valor[i];
+					}
+				}
+				proximos.clear();
+				for( r = 0; r < (int)livres.size(); r++ ){
+					i = livres[r];
+					if(vencedor[alvo[i]] != i) proximos.push_back(i);
+				}
+				for( int t : tocados ){
+					if(dono[t] >= 0){
+						obj[dono[t]] = -1;
+						proximos.push_back(dono[t]);
+					}
+					dono[t] = vencedor[t];
+					obj[vencedor[t]] = t;
+					preco[t] = lance[t];
+					vencedor[t] = -1;
+				}
+				livres.swap(proximos);
+			}
+
+			if(eps == 1) break;
+			eps = max(1LL, eps / 5);
+		}
+
+		col.assign(obj.begin(), obj.begin() + n);
+		return total();
+	}
+};
+
+//Pares permitidos de cada linha (o lado menor), a partir do grafo pessoa -> tarefa. Fica
+//separado do estado da designacao para ser compartilhado pelas threads (ranking de Murty).
+struct ParesDesignacao {
+	int O = 0, D = 0;	//pessoas e tarefas
+	int n = 0, m = 0;	//linhas e colunas internas (n <= m)
+	bool transposta = false;	//linhas sao as tarefas quando O > D
+	vector<int> ini, para, custo;	//pares da linha i: colunas para[ini[i] .. ini[i+1]-1], em ordem
+
+	//Estrela direta do grafo, ou a reversa se transposta
+	void carregar(const Grafo& g){
+		int i, q, k;
+
+		O = g.n;
+		D = g.nDest;
+		transposta = O > D;
+		n = min(O, D);
+		m = max(O, D);
+		ini.assign(n + 1, 0);
+		para.resize(g.m);
+		custo.resize(g.m);
+		for( i = 0; i <= n; i++ ) ini[i] = transposta ? g.inicioInv[i] : g.inicio[i];
+		for( q = 0; q < g.m; q++ ){
+			k = transposta ? g.arcoInv[q] : q;
+			para[q] = transposta ? g.origem[k] : g.destino[k];
+			custo[q] = g.custo[k];
+		}
+	}
+
+	//Indice do par (i, j), ou -1 se nao e permitido
+	int par(int i, int j) const {
+		auto fim = para.begin() + ini[i + 1];
+		auto it = lower_bound(para.begin() + ini[i], fim, j);
+		return it == fim || *it != j ? -1 : it - para.begin();
+	}
+
+	//Tarefa designada a cada pessoa (-1 se ficou sem tarefa)
+	vector<int> tarefas(const vector<int>& col) const {
+		vector<int> t(O, -1);
+		for( int i = 0; i < n; i++ ){
+			if(transposta) t[col[i]] = i;
+			else t[i] = col[i];
+		}
+		return t;
+	}
+
+	long long total(const vector<int>& col) const {
+		long long soma = 0;
+		for( int i = 0; i < n; i++ ) soma += custo[par(i, col[i])];
+		return soma;
+	}
+};
+
+//Designacao so sobre os pares permitidos (pares ausentes sao proibidos). Cada linha livre
+//entra por um caminho aumentante mais curto (Dijkstra nos custos reduzidos c - u - v, que
+//ficam >= 0); memoria e tempo acompanham a quantidade de pares, e nao O*D.
+//Mascaras opcionais restringem o problema: pares proibidos e linhas fixas (que ficam fora,
+//junto com as colunas delas), usadas pelo gargalo e pelo ranking de Murty.
+struct DesignacaoEsparsa {
+	static constexpr long long INF = numeric_limits<long long>::max() / 4;
+
+	const ParesDesignacao* p = nullptr;
+	vector<int> col, lin;	//coluna de cada linha e linha de cada coluna (-1: livre)
+	vector<long long> u, v;	//duais: v <= 0, e v = 0 nas colunas livres
+	vector<char> proibido;	//por par (vazio: nenhum)
+	vector<char> fixa;	//por linha (vazio: nenhuma)
+	vector<char> presa;	//por coluna: colunas das linhas fixas (vazio: nenhuma)
+	long long nFechadas = 0;	//colunas fechadas nos Dijkstras
+
+	//Cancelamento cooperativo (corrida de motores): consultado a cada linha
+	const atomic<bool>* parar = nullptr;
+	bool interrompido = false;
+
+	//Area dos Dijkstras: dist fica em INF e fechada em 0 entre uma busca e outra
+	vector<long long> dist;
+	vector<int> pai, tocadas, fechadas;
+	vector<char> fechada;
+	HeapBinario heap;
+
+	DesignacaoEsparsa(){}
+	DesignacaoEsparsa(const ParesDesignacao& pares) : p(&pares) {}
+
+	vector<int> tarefas() const { return p->tarefas(col); }
+	long long total() const { return p->total(col); }
+
+	bool usavel(int q) const {
+		return (proibido.empty() || !proibido[q]) && (presa.empty() || !presa[p->para[q]]);
+	}
+	bool ativa(int i) const { return fixa.empty() || !fixa[i]; }
+
+	//Reducao de linhas com aumento (Jonker-Volgenant): um leilao sem epsilon que designa a
+	//maior parte das linhas antes dos Dijkstras. Cada linha fica na coluna de menor c - v e
+	//so baixa o v da coluna que toma; as colunas tomadas nunca voltam a ficar livres.
+	void reduzirLinhas(){
+		const ParesDesignacao& P = *p;
+		int i, i0, j1, j2, q, passo;
+		long long u1, u2, h, trocas = 0;
+		size_t k;
+		vector<int> livres, proximos;
+
+		for( i = 0; i < P.n; i++ ) if(ativa(i)) livres.push_back(i);
+		for( passo = 0; passo < 2 && !livres.empty(); passo++ ){
+			proximos.clear();
+			for( k = 0; k < livres.size(); ){
+				i = livres[k++];
+				u1 = u2 = INF;
+				j1 = j2 = -1;
+				for( q = P.ini[i]; q < P.ini[i + 1]; q++ ){
+					if(!usavel(q)) continue;
+					h = P.custo[q] - v[P.para[q]];
+					if(h >= u2) continue;
+					if(h < u1){
+						u2 = u1;
+						j2 = j1;
+						u1 = h;
+						j1 = P.para[q];
+					}else{
+						u2 = h;
+						j2 = P.para[q];
+					}
+				}
+				i0 = lin[j1];
+				if(u2 == INF){
+					//Um par so: se a coluna ja tem dono, fica para os Dijkstras
+					if(i0 >= 0){
+						proximos.push_back(i);
+						continue;
+					}
+				}
+				else if(u1 < u2) v[j1] -= u2 - u1;
+				else if(i0 >= 0){
+					j1 = j2;
+					i0 = lin[j1];
+				}
+				if(i0 >= 0) col[i0] = -1;
+				col[i] = j1;
+				lin[j1] = i;
+				//A linha desalojada disputa de novo em seguida (com limite, contra guerras de lances)
+				if(i0 >= 0){
+					if(u1 < u2 && trocas++ < 4LL * P.n) livres[--k] = i0;
+					else proximos.push_back(i0);
+				}
+			}
+			livres.swap(proximos);
+		}
+	}
+
+	//Caminho aumentante mais curto da linha livre s ate uma coluna livre, com a atualizacao
+	//dos duais. Falso se nenhuma coluna livre e alcancavel.
+	bool aumentar(int s){
+		const ParesDesignacao& P = *p;
+		int i = s, j, q, fim = -1;
+		long long dj = 0, nd, alvo;
+
+		if((int)dist.size() != P.m){
+			dist.assign(P.m, INF);
+			pai.assign(P.m, -1);
+			fechada.assign(P.m, 0);
+		}
+		//Uma linha e alcancada pela coluna a que esta designada
+		heap.clear();
+		while(true){
+			for( q = P.ini[i]; q < P.ini[i + 1]; q++ ){
+				j = P.para[q];
+				if(fechada[j] || !usavel(q)) continue;
+				nd = dj + P.custo[q] - u[i] - v[j];
+				if(nd >= dist[j]) continue;
+				if(dist[j] == INF) tocadas.push_back(j);
+				dist[j] = nd;
+				pai[j] = i;
+				//Chave 2d + ocupada: no empate de distancia a coluna livre sai primeiro
+				heap.push(2 * nd + (lin[j] >= 0), j);
+			}
+			//Proxima coluna aberta de menor distancia (entradas antigas do heap sao descartadas)
+			for( j = -1; j < 0 && !heap.empty(); ){
+				tie(dj, j) = heap.pop();
+				dj >>= 1;
+				if(fechada[j] || dj != dist[j]) j = -1;
+			}
+			if(j < 0) break;
+			fechada[j] = 1;
+			fechadas.push_back(j);
+			if(lin[j] < 0){
+				fim = j;
+				break;
+			}
+			i = lin[j];
+		}
+		nFechadas += fechadas.size();
+
+		if(fim >= 0){
+			//Potenciais: linhas e colunas fechadas andam alvo - distancia (a coluna livre
+			//final tem distancia alvo e continua com v = 0, como todas as livres)
+			alvo = dist[fim];
+			u[s] += alvo;
+			for( int c : fechadas ){
+				if(c == fim) continue;
+				v[c] -= alvo - dist[c];
+				u[lin[c]] += alvo - dist[c];
+			}
+			//Caminho aumentante: cada linha do caminho troca de coluna
+			for( j = fim; ; j = q ){
+				i = pai[j];
+				q = col[i];
+				col[i] = j;
+				lin[j] = i;
+				if(i == s) break;
+			}
+		}
+		for( int c : tocadas ){
+			dist[c] = INF;
+			fechada[c] = 0;
+		}
+		tocadas.clear();
+		fechadas.clear();
+		return fim >= 0;
+	}
+
+	//Falso se nenhuma designacao cobre todas as linhas ativas (ou se a corrida cancelou).
+	//As linhas fixas ficam com col = -1: quem fixou completa col e lin.
+	bool resolver(){
+		const ParesDesignacao& P = *p;
+		int i, q;
+
+		interrompido = false;
+		col.assign(P.n, -1);
+		lin.assign(P.m, -1);
+		u.assign(P.n, INF);
+		v.assign(P.m, 0);
+		for( i = 0; i < P.n; i++ ){
+			if(!ativa(i)) continue;
+			for( q = P.ini[i]; q < P.ini[i + 1] && !usavel(q); q++ );
+			if(q == P.ini[i + 1]) return false;
+		}
+		reduzirLinhas();
+
+		//u = menor c - v da linha, que nas designadas e o da propria coluna: custos reduzidos
+		//c - u - v >= 0 e zero nos pares designados; as colunas livres continuam com v = 0
+		for( i = 0; i < P.n; i++ ){
+			if(!ativa(i)) continue;
+			for( q = P.ini[i]; q < P.ini[i + 1]; q++ ) if(usavel(q)) u[i] = min(u[i], P.custo[q] - v[P.para[q]]);
+		}
+
+		return completar();
+	}
+
+	//Caminhos aumentantes para as linhas ativas ainda sem coluna (duais ja viaveis)
+	bool completar(){
+		for( int s = 0; s < p->n; s++ ){
+			if(!ativa(s) || col[s] >= 0) continue;
+			if(parar != nullptr && parar->load(memory_order_relaxed)){
+				interrompido = true;
+				return false;
+			}
+			if(!aumentar(s)) return false;
+		}
+		return true;
+	}
+
+	//Emparelhamento maximo so com os pares de custo <= limite (Hopcroft-Karp). par[i] e o par
+	//da linha i e dono[j] a linha da coluna j, aproveitados da chamada anterior (os pares
+	//acima do limite saem). Devolve o tamanho do emparelhamento.
+	int emparelhar(long long limite, vector<int>& par, vector<int>& dono) const {
+		const ParesDesignacao& P = *p;
+		int i, j, q, r, tam = 0;
+		size_t f;
+		bool achou;
+		vector<int> nivel(P.n), it(P.n), fila, pilha;
+
+		for( i = 0; i < P.n; i++ ){
+			if(par[i] >= 0 && P.custo[par[i]] > limite){
+				dono[P.para[par[i]]] = -1;
+				par[i] = -1;
+			}
+			if(par[i] >= 0) tam++;
+		}
+		while(true){
+			//Niveis por BFS a partir das linhas livres
+			fila.clear();
+			for( i = 0; i < P.n; i++ ){
+				nivel[i] = par[i] < 0 ? 0 : -1;
+				if(par[i] < 0) fila.push_back(i);
+			}
+			achou = false;
+			for( f = 0; f < fila.size(); f++ ){
+				i = fila[f];
+				for( q = P.ini[i]; q < P.ini[i + 1]; q++ ){
+					if(P.custo[q] > limite) continue;
+					r = dono[P.para[q]];
+					if(r < 0) achou = true;
+					else if(nivel[r] < 0){
+						nivel[r] = nivel[i] + 1;
+						fila.push_back(r);
+					}
+				}
+			}
+			if(!achou) return tam;
+
+			//Caminhos aumentantes disjuntos pelos niveis (DFS iterativa)
+			for( i = 0; i < P.n; i++ ) it[i] = P.ini[i];
+			for( int s = 0; s < P.n; s++ ){
+				if(par[s] >= 0) continue;
+				pilha.assign(1, s);
+				while(!pilha.empty()){
+					i = pilha.back();
+					if(it[i] == P.ini[i + 1]){
+						nivel[i] = -1;
+						pilha.pop_back();
+						continue;
+					}
+					q = it[i];
+					j = P.para[q];
+					r = dono[j];
+					if(P.custo[q] > limite || (r >= 0 && nivel[r] != nivel[i] + 1)){
+						it[i]++;
+						continue;
+					}
+					if(r >= 0){
+						pilha.push_back(r);
+						continue;
+					}
+					//Coluna livre: cada linha da pilha fica com o par em que parou
+					for( int l : pilha ){
+						par[l] = it[l];
+						dono[P.para[it[l]]] = l;
+					}
+					tam++;
+					pilha.clear();
+				}
+			}
+		}
+	}
+
+	//Designacao de menor gargalo (maior custo usado): busca binaria nos custos distintos com
+	//o emparelhamento maximo so nos pares ate o limiar; entre as de menor gargalo, fica a de
+	//menor soma (resolver() com os pares acima do limiar proibidos)
+	bool gargalo(long long& limiar){
+		const ParesDesignacao& P = *p;
+		vector<int> par(P.n, -1), dono(P.m, -1);
+		vector<int> custos(P.custo.begin(), P.custo.end());
+		int a = 0, b, meio;
+		bool ok;
+
+		limiar = 0;
+		sort(custos.begin(), custos.end());
+		custos.erase(unique(custos.begin(), custos.end()), custos.end());
+		if(custos.empty()) return P.n == 0 && resolver();
+		b = custos.size() - 1;
+		if(emparelhar(custos[b], par, dono) < P.n) return false;
+		while(a < b){
+			meio = (a + b) / 2;
+			if(emparelhar(custos[meio], par, dono) == P.n) b = meio;
+			else a = meio + 1;
+		}
+		limiar = custos[a];
+
+		proibido.assign(P.custo.size(), 0);
+		for( size_t q = 0; q < P.custo.size(); q++ ) proibido[q] = P.custo[q] > limiar;
+		ok = resolver();
+		proibido.clear();
+		return ok;
+	}
+};
+
+#endif
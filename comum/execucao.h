@@ -0,0 +1,300 @@
+/*---------------- File: execucao.h  --------------------+
+|Camada comum aos cinco problemas                        |
+|					      		                        |
+| Estado global (motor, saida, medicao, ambiente CPLEX), |
+| a interface Problema e o laco de instancias com a      |
+| linha de comando compartilhada (executar).             |
++-------------------------------------------------------+ */
+
+#ifndef EXECUCAO_H
+#define EXECUCAO_H
+
+#include <bits/stdc++.h>
+#ifndef SEM_CPLEX
+#include <ilcplex/ilocplex.h>
+#endif
+#include "grafo.h"
+#include "lote.h"
+#include "binario.h"
+#include "leitor.h"
+#include "saida.h"
+#include "medicao.h"
+#include "parametros_cplex.h"
+
+using namespace std;
+#ifndef SEM_CPLEX
+ILOSTLBEGIN //MACRO - "using namespace" for ILOCPEX
+#endif
+
+//Estado do processo, compartilhado por todos os problemas. Motor, saida e medicao sao por
+//thread: na corrida (--engine=portfolio) cada motor tem os seus e so o vencedor e emitido.
+inline thread_local string motor; //Motor de resolucao (--engine=): cplex, ou o primeiro nativo quando compilado sem CPLEX
+inline bool relaxacaoLP = false; //--lp: resolve a relaxacao linear (matriz totalmente unimodular: o otimo ja e inteiro)
+inline thread_local Saida saida; //Saida das solucoes: --quiet e --output=text|jsonl|binary
+inline thread_local Medicao medicao; //Tempo de cada fase e pico de memoria (--stats=)
+inline InstanciaBinaria mapa; //Instancia binaria da vez (colunas do grafo apontam para ela)
+inline ParametrosCplex parametrosCplex; //--cplex-<chave>=valor e --cplex-config=arquivo
+
+#ifndef SEM_CPLEX
+inline IloEnv env; //Ambiente do CPLEX, um por processo
+inline IloCplex::Aborter abortador(env); //Cancela o CPLEX do Concert quando outro motor vence a corrida
+#endif
+
+//Corrida de motores (--engine=portfolio): todos resolvem a mesma instancia carregada, cada um
+//numa thread; o primeiro "Optimal" vence e os demais sao cancelados (os nativos consultam
+//cancelada, o CPLEX recebe abort()/CPXsetterminate). Motores sem ponto de cancelamento
+//terminam normalmente, depois que o vencedor ja foi emitido.
+struct Corrida {
+	vector<string> motores;	//--portfolio=a,b,... (padrao: cplex e todos os nativos)
+	atomic<bool> cancelada{false};
+	volatile int terminar = 0;	//CPXsetterminate (carga em bloco, matriz_cplex.h)
+	bool ativa = false;
+	string vencedor;
+
+	void iniciar(){
+		cancelada = false;
+		terminar = 0;
+		ativa = true;
+		vencedor.clear();
+#ifndef SEM_CPLEX
+		abortador.clear();
+#endif
+	}
+	void cancelar(){
+		cancelada = true;
+		terminar = 1;
+#ifndef SEM_CPLEX
+		abortador.abort();
+#endif
+	}
+};
+inline Corrida corrida;
+
+#ifndef SEM_CPLEX
+
+//Consumo do CPLEX e pico do processo (modo detalhado)
+inline void memoriaCplex(const char* momento){
+	cout << "Memory usage " << momento << ":  " << env.getMemoryUsage() / (1024. * 1024.) << " MB (pico RSS: " << Medicao::mb(Medicao::picoRSS()) << " MB)" << endl;
+}
+
+//Parametros, log (so no modo detalhado) e resolucao do modelo extraido; devolve o status da FO
+inline string resolverCplex(IloCplex& cplex, bool& sol){
+	string status;
+
+	//Setting CPLEX Parameters
+	parametrosCplex.aplicar(cplex);
+	if(corrida.ativa) cplex.use(abortador);
+	if(saida.detalhes()) parametrosCplex.imprimir();
+	if(!saida.detalhes()){
+		cplex.setOut(env.getNullStream());
+		cplex.setWarning(env.getNullStream());
+	}
+
+	medicao.comecar();
+	cplex.solve();//COMANDO DE EXECUCAO
+	medicao.parar(Medicao::RESOLUCAO);
+	medicao.memoriaSolver = env.getMemoryUsage();
+
+	//cout << "Solution Status: " << cplex.getStatus() << endl;
+	sol = true;
+	switch(cplex.getStatus()){
+		case IloAlgorithm::Optimal:
+			status = "Optimal";
+			break;
+		case IloAlgorithm::Feasible:
+			status = "Feasible";
+			break;
+		default:
+			status = "No Solution";
+			sol = false;
+	}
+	return status;
+}
+#endif
+
+//O que cada problema entrega ao laco comum. Os dados da instancia ficam no namespace do problema.
+struct Problema {
+	string nome;	//pcm, pd, pfcm, pfmax ou pt (o --problem= do solve)
+	vector<string> nativos;	//motores nativos aceitos em --engine= (o primeiro e o padrao sem CPLEX)
+
+	Problema(const string& n, const vector<string>& m) : nome(n), nativos(m) {}
+	virtual ~Problema(){}
+
+	virtual bool argumento(const char*){ return false; }	//argumento proprio (true: reconhecido)
+	virtual bool validar(){ return true; }	//confere os argumentos proprios (a mensagem sai no stderr)
+	virtual bool ler(istream& in, const string& instancia) = 0;	//in.txt
+	virtual bool lerBinario() = 0;	//instancia ja mapeada em mapa
+	virtual void eco() = 0;	//Verificacao da leitura dos dados
+	virtual void nativo() = 0;
+#ifndef SEM_CPLEX
+	virtual void cplex() = 0;
+#endif
+	virtual bool laco(Lote&){ return false; }	//laco proprio no lugar do comum (true: ja resolveu)
+	virtual void liberar(){}	//modelo mantido entre as instancias
+};
+
+//Corrida: cada motor numa thread com saida e medicao proprias; o registro do vencedor sai
+//assim que ele termina, e so depois as threads dos demais sao esperadas
+inline void correr(Problema& p){
+	int n = corrida.motores.size(), vencedor = -1;
+	vector<Saida> saidas(n);
+	vector<Medicao> medicoes(n);
+	vector<int> ordem; //motores na ordem em que terminaram
+	vector<thread> threads;
+	mutex mtx;
+	condition_variable cv;
+	string formato = saida.formato, instancia = saida.instancia;
+
+	corrida.iniciar();
+	for( int i = 0; i < n; i++ ){
+		threads.emplace_back([&, i]{
+			motor = corrida.motores[i];
+			saida.formato = formato;
+			saida.quieto = true;
+			saida.adiada = true;
+			saida.iniciar(instancia);
+			medicao.zerar();
+			if(motor != "cplex") p.nativo();
+#ifndef SEM_CPLEX
+			else p.cplex();
+#endif
+			lock_guard<mutex> lk(mtx);
+			saidas[i] = saida;
+			medicoes[i] = medicao;
+			ordem.push_back(i);
+			if(vencedor < 0 && saida.estado == "Optimal"){
+				vencedor = i;
+				corrida.cancelar();
+			}
+			cv.notify_one();
+		});
+	}
+	{
+		unique_lock<mutex> lk(mtx);
+		cv.wait(lk, [&]{ return vencedor >= 0 || (int)ordem.size() == n; });
+		//Sem otimo provado: o primeiro que terminou com solucao, ou o primeiro que emitiu algum
+		//status; se todos recusaram a instancia, sai No Solution
+		if(vencedor < 0) for( int i : ordem ) if(vencedor < 0 && saidas[i].sol) vencedor = i;
+		if(vencedor < 0) for( int i : ordem ) if(vencedor < 0 && !saidas[i].estado.empty()) vencedor = i;
+		if(vencedor < 0) vencedor = ordem[0];
+		corrida.vencedor = corrida.motores[vencedor];
+		if(saida.detalhes()){
+			printf("--------Informacoes da Execucao:----------\n\n");
+			printf("Motor: corrida (");
+			for( int i = 0; i < n; i++ ) printf("%s%s", i ? ", " : "", corrida.motores[i].c_str());
+			printf("), vencedor: %s\n", corrida.vencedor.c_str());
+		}
+		saida.adotar(saidas[vencedor]);
+		medicao.somar(medicoes[vencedor]);
+		saida.emitir(saidas[vencedor].estado.empty() ? "No Solution" : saidas[vencedor].estado);
+	}
+	for( auto& t : threads ) t.join();
+	corrida.ativa = false;
+}
+
+//Resolve a instancia carregada com o motor escolhido e registra as medicoes
+inline void resolver(Problema& p){
+	string usado = motor;
+	if(motor == "portfolio"){
+		correr(p);
+		usado = "portfolio:" + corrida.vencedor;
+	}
+	else if(motor != "cplex") p.nativo();
+#ifndef SEM_CPLEX
+	else p.cplex();
+#endif
+
+	if(saida.detalhes()) medicao.imprimir();
+	medicao.parametros = usado == "cplex" || usado == "portfolio:cplex" ? parametrosCplex.json() : "";
+	medicao.registrar(saida.instancia, usado, saida.estado);
+}
+
+//Linha de comando comum e laco das instancias (stdin ou modo lote)
+inline int executar(Problema& p, int argc, char* argv[]){
+	Lote lote; //Instancias a resolver: so stdin fora do modo lote
+	istream* in;
+
+#ifdef SEM_CPLEX
+	motor = p.nativos[0]; //compilado sem CPLEX (make nativo)
+#else
+	motor = "cplex";
+#endif
+	for(int a=1; a<argc; a++) {
+		if(strncmp(argv[a], "--engine=", 9) == 0) motor = argv[a] + 9;
+		if(strncmp(argv[a], "--portfolio=", 12) == 0) {
+			motor = "portfolio";
+			istringstream lista(argv[a] + 12);
+			string m;
+			corrida.motores.clear();
+			while(getline(lista, m, ',')) {
+				if(find(corrida.motores.begin(), corrida.motores.end(), m) == corrida.motores.end()) corrida.motores.push_back(m);
+			}
+		}
+		if(strcmp(argv[a], "--lp") == 0) relaxacaoLP = true;
+		if(strcmp(argv[a], "--quiet") == 0) saida.quieto = true;
+		if(strncmp(argv[a], "--stats=", 8) == 0) medicao.arquivo = argv[a] + 8;
+		if(strncmp(argv[a], "--output=", 9) == 0) saida.formato = argv[a] + 9;
+		if(strncmp(argv[a], "--cplex-", 8) == 0) parametrosCplex.argumento(argv[a] + 8);
+		p.argumento(argv[a]);
+		if(strcmp(argv[a], "--batch") == 0) lote.ativo = true;
+		else if(argv[a][0] != '-') lote.adicionar(argv[a]);
+	}
+	auto conhecido = [&](const string& m){ return m == "cplex" || find(p.nativos.begin(), p.nativos.end(), m) != p.nativos.end(); };
+	if(motor == "portfolio" && corrida.motores.empty()) {
+#ifndef SEM_CPLEX
+		corrida.motores.push_back("cplex");
+#endif
+		corrida.motores.insert(corrida.motores.end(), p.nativos.begin(), p.nativos.end());
+	}
+	for( const string& m : motor == "portfolio" ? corrida.motores : vector<string>{motor} ) {
+		if(conhecido(m)) continue;
+		string opcoes = "--engine=cplex";
+		for( const string& n : p.nativos ) opcoes += " ou --engine=" + n;
+		fprintf(stderr, "Motor desconhecido: %s (use %s ou --engine=portfolio)\n", m.c_str(), opcoes.c_str());
+		return 1;
+	}
+	if(!p.validar()) return 1;
+	if(!parametrosCplex.erro.empty()) {
+		fprintf(stderr, "Parametro do CPLEX invalido: %s (veja comum/parametros_cplex.h)\n", parametrosCplex.erro.c_str());
+		return 1;
+	}
+	if(!saida.valido()) {
+		fprintf(stderr, "Formato de saida desconhecido: %s (use --output=text ou --output=jsonl ou --output=binary)\n", saida.formato.c_str());
+		return 1;
+	}
+	if(!medicao.abrir()) {
+		fprintf(stderr, "Nao foi possivel abrir %s\n", medicao.arquivo.c_str());
+		return 1;
+	}
+#ifdef SEM_CPLEX
+	if(motor == "cplex" || find(corrida.motores.begin(), corrida.motores.end(), "cplex") != corrida.motores.end()) {
+		fprintf(stderr, "Executavel compilado sem CPLEX: use --engine=%s\n", p.nativos[0].c_str());
+		return 1;
+	}
+#endif
+
+	if(!p.laco(lote)) while((in = lote.proxima()) != nullptr) {
+		medicao.zerar();
+		if(saida.texto()) lote.cabecalho();
+		if(!(mapa.abrir(lote.caminho()) ? p.lerBinario() : !mapa.corrompido && p.ler(*in, lote.nome))) {
+			fprintf(stderr, "Instancia %s vazia ou incompleta\n", lote.nome.c_str());
+			continue;
+		}
+		saida.iniciar(lote.nome);
+
+		if(saida.detalhes()) p.eco();
+		resolver(p);
+	}
+
+	p.liberar();
+	return 0;
+}
+
+//Fim do processo: depois do ultimo executar()
+inline void encerrar(){
+#ifndef SEM_CPLEX
+	env.end();
+#endif
+}
+
+#endif
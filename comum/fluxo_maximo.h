@@ -0,0 +1,346 @@
+/*---------------- File: fluxo_maximo.h  ----------------+
+|Fluxo Maximo - Push-Relabel (maior rotulo)              |
+|					      		                        |
+| Duas fases: a primeira calcula o pre-fluxo maximo com  |
+| reetiquetagem global e heuristica de gap; a segunda    |
+| devolve o excesso restante para a origem.              |
++-------------------------------------------------------+ */
+
+#ifndef FLUXO_MAXIMO_H
+#define FLUXO_MAXIMO_H
+
+#include <bits/stdc++.h>
+#include "grafo.h"
+
+using namespace std;
+
+struct FluxoMaximo {
+	//Frequencia da reetiquetagem global: trabalho > ALFA*n + m
+	static constexpr int ALFA = 6;
+	static constexpr int BETA = 12;
+
+	int n, m;
+	const Grafo* g;
+
+	//Grafo residual: arestas de v em [ini[v], ini[v+1]); primeiro os arcos de saida
+	//(na ordem de g), depois os reversos dos arcos de chegada. rev liga os pares.
+	vector<int> ini, para, rev;
+	vector<long long> res;
+
+	vector<long long> excesso;
+	vector<int> rotulo, atual;
+
+	//Vertices ativos por rotulo (entradas antigas sao ignoradas ao sair do balde)
+	vector<vector<int>> balde;
+	int maxAtivo;
+
+	//Todos os vertices vivos por rotulo, para a heuristica de gap
+	vector<int> cab, prox, ant;
+	int maxRotulo;
+
+	long long trabalho;
+
+	//Busca de cobrir(), mantida entre as chamadas: so os vertices vistos voltam a zero
+	vector<int> paiFalta, pilhaFalta, vistosFalta;
+	vector<char> vistoFalta;
+
+	long long nPush = 0, nRelabel = 0, nGlobal = 0, nGap = 0;
+
+	//Cancelamento cooperativo (corrida de motores): consultado a cada 1024 descargas
+	const atomic<bool>* parar = nullptr;
+	bool interrompido = false;
+	long long descargas = 0;
+
+	//Aresta residual direta do arco k
+	int direta(int k) const {
+		return ini[g->origem[k]] + (k - g->inicio[g->origem[k]]);
+	}
+
+	//Fluxo no arco k (capacidade em g.cap)
+	long long fluxo(int k) const {
+		return g->cap[k] - res[direta(k)];
+	}
+
+	void construir(const Grafo& grafo){
+		int v, k, p, e;
+
+		g = &grafo;
+		n = grafo.n;
+		m = grafo.m;
+
+		ini.assign(n + 1, 0);
+		for( v = 0; v < n; v++ ){
+			ini[v + 1] = ini[v] + (grafo.inicio[v + 1] - grafo.inicio[v]) + (grafo.inicioInv[v + 1] - grafo.inicioInv[v]);
+		}
+		para.resize(2 * m);
+		rev.resize(2 * m);
+		res.resize(2 * m);
+
+		for( v = 0; v < n; v++ ){
+			for( k = grafo.inicio[v]; k < grafo.inicio[v + 1]; k++ ){
+				e = ini[v] + (k - grafo.inicio[v]);
+				para[e] = grafo.destino[k];
+				res[e] = grafo.cap[k];
+			}
+			for( p = grafo.inicioInv[v]; p < grafo.inicioInv[v + 1]; p++ ){
+				k = grafo.arcoInv[p];
+				e = ini[v] + (grafo.inicio[v + 1] - grafo.inicio[v]) + (p - grafo.inicioInv[v]);
+				para[e] = grafo.origem[k];
+				res[e] = 0;
+				rev[e] = direta(k);
+				rev[direta(k)] = e;
+			}
+		}
+
+		excesso.assign(n, 0);
+		rotulo.assign(n, 0);
+		atual.assign(n, 0);
+		balde.assign(n + 1, vector<int>());
+		cab.assign(n + 1, -1);
+		prox.assign(n, -1);
+		ant.assign(n, -1);
+	}
+
+	void inserir(int v){
+		int l = rotulo[v];
+		prox[v] = cab[l];
+		ant[v] = -1;
+		if(cab[l] >= 0) ant[cab[l]] = v;
+		cab[l] = v;
+		if(l > maxRotulo) maxRotulo = l;
+	}
+
+	void remover(int v){
+		if(ant[v] >= 0) prox[ant[v]] = prox[v];
+		else cab[rotulo[v]] = prox[v];
+		if(prox[v] >= 0) ant[prox[v]] = ant[v];
+	}
+
+	void ativar(int v){
+		balde[rotulo[v]].push_back(v);
+		if(rotulo[v] > maxAtivo) maxAtivo = rotulo[v];
+	}
+
+	//Distancia exata ate o alvo no grafo residual; quem nao alcanca o alvo recebe n
+	void reetiquetagemGlobal(int alvo, int fonte){
+		int v, x, y, e;
+		vector<int> fila;
+
+		fill(rotulo.begin(), rotulo.end(), n);
+		rotulo[alvo] = 0;
+		fila.reserve(n);
+		fila.push_back(alvo);
+		for( size_t q = 0; q < fila.size(); q++ ){
+			x = fila[q];
+			for( e = ini[x]; e < ini[x + 1]; e++ ){
+				y = para[e];
+				if(rotulo[y] == n && y != fonte && res[rev[e]] > 0){
+					rotulo[y] = rotulo[x] + 1;
+					fila.push_back(y);
+				}
+			}
+		}
+
+		for( v = 0; v <= maxAtivo && v <= n; v++ ) balde[v].clear();
+		fill(cab.begin(), cab.end(), -1);
+		maxAtivo = -1;
+		maxRotulo = 0;
+		for( v = 0; v < n; v++ ){
+			atual[v] = ini[v];
+			if(v == fonte || rotulo[v] >= n) continue;
+			inserir(v);
+			if(v != alvo && excesso[v] > 0) ativar(v);
+		}
+		trabalho = 0;
+		nGlobal++;
+	}
+
+	//Todo vertice vivo com rotulo acima de l deixa de alcancar o alvo
+	void gap(int l){
+		int v, k;
+		for( k = l + 1; k <= maxRotulo; k++ ){
+			for( v = cab[k]; v >= 0; v = prox[v] ) rotulo[v] = n;
+			cab[k] = -1;
+		}
+		maxRotulo = l - 1;
+		nGap++;
+	}
+
+	void relabel(int u){
+		int e, fim = ini[u + 1], novo = n, arg = ini[u];
+		int antigo = rotulo[u];
+
+		for( e = ini[u]; e < fim; e++ ){
+			if(res[e] > 0 && rotulo[para[e]] + 1 < novo){
+				novo = rotulo[para[e]] + 1;
+				arg = e;
+			}
+		}
+		trabalho += BETA + (fim - ini[u]);
+		nRelabel++;
+
+		remover(u);
+		if(cab[antigo] < 0){
+			gap(antigo);
+			rotulo[u] = n;
+			return;
+		}
+		rotulo[u] = novo;
+		atual[u] = arg;
+		if(novo < n) inserir(u);
+	}
+
+	void descarregar(int u, int alvo){
+		int e, v, fim = ini[u + 1];
+		long long delta;
+
+		while(excesso[u] > 0){
+			for( e = atual[u]; e < fim; e++ ){
+				v = para[e];
+				if(res[e] > 0 && rotulo[v] + 1 == rotulo[u]){
+					delta = min(excesso[u], res[e]);
+					if(v != alvo && excesso[v] == 0) ativar(v);
+					res[e] -= delta;
+					res[rev[e]] += delta;
+					excesso[u] -= delta;
+					excesso[v] += delta;
+					nPush++;
+					if(excesso[u] == 0) break;
+				}
+			}
+			if(e < fim){
+				atual[u] = e;
+				break;
+			}
+			relabel(u);
+			if(rotulo[u] >= n) break;
+		}
+	}
+
+	//Push-relabel de maior rotulo levando o excesso em direcao ao alvo
+	void fase(int alvo, int fonte){
+		int u, l;
+
+		maxAtivo = -1;
+		reetiquetagemGlobal(alvo, fonte);
+		while(maxAtivo >= 0){
+			l = maxAtivo;
+			if(balde[l].empty()){
+				maxAtivo--;
+				continue;
+			}
+			u = balde[l].back();
+			balde[l].pop_back();
+			if(rotulo[u] != l || excesso[u] == 0) continue;
+
+			descarregar(u, alvo);
+
+			if(trabalho > (long long)ALFA * n + m) reetiquetagemGlobal(alvo, fonte);
+			if((++descargas & 1023) == 0 && parar != nullptr && parar->load(memory_order_relaxed)){
+				interrompido = true;
+				return;
+			}
+		}
+	}
+
+	//Valor do fluxo maximo de s para t
+	long long resolver(const Grafo& grafo, int s, int t){
+		construir(grafo);
+		if(s == t) return 0;
+		return reotimizar(s, t);
+	}
+
+	//Troca a capacidade do arco k depois de resolver() (g.cap[k] fica a cargo de quem chama).
+	//Se o fluxo passa do novo limite, a sobra fica como excesso na origem do arco e a falta no
+	//destino e coberta cancelando fluxo em caminhos ate um vertice com excesso (o alvo ou a
+	//origem de outro arco reduzido). O fluxo continua valido para reotimizar().
+	void alterarCapacidade(int k, long long c, int s, int t){
+		int e = direta(k), u = g->origem[k], v = g->destino[k];
+		long long f = res[rev[e]];
+
+		if(f <= c){
+			res[e] = c - f;
+			return;
+		}
+		res[e] = 0;
+		res[rev[e]] = c;
+		excesso[u] += f - c;
+		excesso[v] -= f - c;
+		if(v != s && v != t) cobrir(v);
+	}
+
+	//Cancela fluxo a partir de v (com falta) por arcos com fluxo ate vertices com excesso
+	void cobrir(int v){
+		vector<int>& pai = paiFalta;
+		vector<int>& pilha = pilhaFalta;
+		vector<int>& vistos = vistosFalta;
+		vector<char>& visto = vistoFalta;
+
+		if(visto.size() != (size_t)n){
+			pai.assign(n, -1);
+			visto.assign(n, 0);
+		}
+		while(excesso[v] < 0){
+			int x = -1, e;
+			for( int y : vistos ) visto[y] = 0;
+			vistos.assign(1, v);
+			pilha.assign(1, v);
+			visto[v] = 1;
+			while(!pilha.empty() && x < 0){
+				int y = pilha.back();
+				pilha.pop_back();
+				int saida = ini[y] + (g->inicio[y + 1] - g->inicio[y]);
+				for( e = ini[y]; e < saida; e++ ){
+					int z = para[e];
+					if(visto[z] || res[rev[e]] == 0) continue;
+					visto[z] = 1;
+					vistos.push_back(z);
+					pai[z] = e;
+					if(excesso[z] > 0){
+						x = z;
+						break;
+					}
+					pilha.push_back(z);
+				}
+			}
+			//Sempre existe: a falta em v so e compensada por excesso alcancavel pelo fluxo
+			if(x < 0) break;
+
+			long long delta = min(-excesso[v], excesso[x]);
+			for( int z = x; z != v; z = para[rev[pai[z]]] ) delta = min(delta, res[rev[pai[z]]]);
+			for( int z = x; z != v; z = para[rev[pai[z]]] ){
+				res[pai[z]] += delta;
+				res[rev[pai[z]]] -= delta;
+			}
+			excesso[x] -= delta;
+			excesso[v] += delta;
+		}
+		for( int y : vistos ) visto[y] = 0;
+		vistos.clear();
+	}
+
+	//Continua de um fluxo valido (o inicial zero ou o de antes de alterarCapacidade()):
+	//satura de novo a origem e repete as duas fases a partir dos residuos atuais
+	long long reotimizar(int s, int t){
+		int e;
+
+		//Satura as arestas que saem da origem
+		for( e = ini[s]; e < ini[s + 1]; e++ ){
+			if(res[e] > 0){
+				excesso[para[e]] += res[e];
+				excesso[s] -= res[e];
+				res[rev[e]] += res[e];
+				res[e] = 0;
+			}
+		}
+
+		//Fase 1: pre-fluxo maximo; Fase 2: excesso de volta para a origem
+		interrompido = false;
+		fase(t, s);
+		if(!interrompido) fase(s, t);
+
+		return excesso[t];
+	}
+};
+
+#endif
@@ -0,0 +1,225 @@
+/*---------------- File: fluxo_paralelo.h  --------------+
+|Fluxo Maximo - Push-Relabel sincrono em paralelo        |
+|					      		                        |
+| Rodadas: todos os ativos empurram ao mesmo tempo pelos |
+| rotulos do inicio da rodada, depois reetiquetam. O     |
+| resultado nao depende da quantidade de threads.        |
++-------------------------------------------------------+ */
+
+#ifndef FLUXO_PARALELO_H
+#define FLUXO_PARALELO_H
+
+#include <bits/stdc++.h>
+#include "fluxo_maximo.h"
+#include "paralelo.h"
+
+using namespace std;
+
+/*
+* Numa rodada, v so empurra para w com rotulo[w] == rotulo[v] - 1; w nao pode empurrar
+* de volta para v na mesma rodada, entao cada par de arestas residuais tem um unico
+* escritor e res dispensa operacoes atomicas. So o excesso recebido e somado com
+* fetch_add. A reetiquetagem usa os rotulos antigos e grava em novo[], o que mantem a
+* rotulagem valida. A reetiquetagem global e uma BFS por niveis, com a fronteira dividida
+* entre as threads.
+*/
+struct FluxoParalelo {
+	FluxoMaximo r;	//grafo residual e excessos, no mesmo formato do motor serial
+	int n = 0, m = 0;
+	vector<int> rotulo, novo, ativos, frente;
+	vector<long long> sobra;	//excesso que fica no ativo depois dos pushes da rodada
+	unique_ptr<atomic<long long>[]> recebido;	//excesso recebido na rodada
+	unique_ptr<atomic<int>[]> marca;	//ultima rodada em que o vertice entrou na lista de ativos
+	unique_ptr<atomic<int>[]> visita;	//ultima BFS que alcancou o vertice
+	int rodada = 0, carimbo = 0;
+	vector<vector<int>> listas;	//lista local de cada thread
+	vector<long long> contPush, contRelabel, contTrabalho;
+	long long nRodadas = 0, nPush = 0, nRelabel = 0, nGlobal = 0;
+
+	//Cancelamento cooperativo (corrida de motores): consultado a cada rodada
+	const atomic<bool>* parar = nullptr;
+	bool interrompido = false;
+
+	long long fluxo(int k) const { return r.fluxo(k); }
+
+	//Junta as listas locais das threads em destino
+	void juntar(vector<int>& destino){
+		destino.clear();
+		for( vector<int>& l : listas ){
+			destino.insert(destino.end(), l.begin(), l.end());
+			l.clear();
+		}
+	}
+
+	//Distancia exata ate o alvo; quem nao alcanca recebe n. Refaz a lista de ativos.
+	void reetiquetagemGlobal(int alvo, int fonte, Equipe& equipe){
+		int nivel = 0;
+
+		carimbo++;
+		equipe.paraCada(n, [&](int ini, int fim, int){
+			for( int v = ini; v < fim; v++ ) rotulo[v] = n;
+		});
+		rotulo[alvo] = 0;
+		visita[alvo] = carimbo;
+		frente.assign(1, alvo);
+		while(!frente.empty()){
+			nivel++;
+			equipe.paraCada(frente.size(), [&](int ini, int fim, int id){
+				vector<int>& local = listas[id];
+				for( int q = ini; q < fim; q++ ){
+					int x = frente[q];
+					for( int e = r.ini[x]; e < r.ini[x + 1]; e++ ){
+						int y = r.para[e];
+						if(y == fonte || r.res[r.rev[e]] == 0 || visita[y].load(memory_order_relaxed) == carimbo) continue;
+						if(visita[y].exchange(carimbo) == carimbo) continue;
+						rotulo[y] = nivel;
+						local.push_back(y);
+					}
+				}
+			});
+			juntar(frente);
+		}
+
+		rodada++;
+		equipe.paraCada(n, [&](int ini, int fim, int id){
+			for( int v = ini; v < fim; v++ ){
+				if(v == alvo || v == fonte || rotulo[v] >= n || r.excesso[v] <= 0) continue;
+				marca[v] = rodada;
+				listas[id].push_back(v);
+			}
+		});
+		juntar(ativos);
+		nGlobal++;
+	}
+
+	//Rodadas sincronas levando o excesso em direcao ao alvo
+	void fase(int alvo, int fonte, Equipe& equipe){
+		long long trabalho = 0;
+
+		reetiquetagemGlobal(alvo, fonte, equipe);
+		while(!ativos.empty()){
+			rodada++;
+			nRodadas++;
+
+			//Pushes pelos rotulos do inicio da rodada
+			equipe.paraCada(ativos.size(), [&](int ini, int fim, int id){
+				vector<int>& local = listas[id];
+				for( int q = ini; q < fim; q++ ){
+					int v = ativos[q], d = rotulo[v];
+					long long e = r.excesso[v];
+					//Rotulo n: recebeu nesta rodada, mas ja nao alcanca o alvo
+					for( int a = r.ini[v]; a < r.ini[v + 1] && e > 0 && d < n; a++ ){
+						int w = r.para[a];
+						//O rotulo vem antes do residuo: so o dono le e grava este par na rodada
+						if(rotulo[w] + 1 != d || r.res[a] == 0) continue;
+						long long delta = min(e, r.res[a]);
+						r.res[a] -= delta;
+						r.res[r.rev[a]] += delta;
+						e -= delta;
+						recebido[w].fetch_add(delta, memory_order_relaxed);
+						contPush[id]++;
+						if(w != alvo && w != fonte && marca[w].exchange(rodada) != rodada) local.push_back(w);
+					}
+					sobra[v] = e;
+				}
+			});
+
+			//Reetiquetagem de quem ficou com excesso (rotulos antigos, resultado em novo)
+			equipe.paraCada(ativos.size(), [&](int ini, int fim, int id){
+				vector<int>& local = listas[id];
+				for( int q = ini; q < fim; q++ ){
+					int v = ativos[q], menor = n;
+					novo[v] = rotulo[v];
+					if(sobra[v] == 0) continue;
+					for( int a = r.ini[v]; a < r.ini[v + 1]; a++ ){
+						if(r.res[a] > 0 && rotulo[r.para[a]] + 1 < menor) menor = rotulo[r.para[a]] + 1;
+					}
+					novo[v] = menor;
+					contRelabel[id]++;
+					contTrabalho[id] += FluxoMaximo::BETA + (r.ini[v + 1] - r.ini[v]);
+					if(menor < n && marca[v].exchange(rodada) != rodada) local.push_back(v);
+				}
+			});
+
+			equipe.paraCada(ativos.size(), [&](int ini, int fim, int){
+				for( int q = ini; q < fim; q++ ){
+					int v = ativos[q];
+					rotulo[v] = novo[v];
+					r.excesso[v] = sobra[v];
+				}
+			});
+			juntar(ativos);
+
+			//Excesso recebido: so os novos ativos, o alvo e a fonte podem ter recebido
+			equipe.paraCada(ativos.size(), [&](int ini, int fim, int){
+				for( int q = ini; q < fim; q++ ){
+					int v = ativos[q];
+					r.excesso[v] += recebido[v].exchange(0, memory_order_relaxed);
+				}
+			});
+			r.excesso[alvo] += recebido[alvo].exchange(0);
+			r.excesso[fonte] += recebido[fonte].exchange(0);
+
+			for( long long& c : contTrabalho ){
+				trabalho += c;
+				c = 0;
+			}
+			if(parar != nullptr && parar->load(memory_order_relaxed)){
+				interrompido = true;
+				return;
+			}
+			if(trabalho > (long long)FluxoMaximo::ALFA * n + m){
+				reetiquetagemGlobal(alvo, fonte, equipe);
+				trabalho = 0;
+			}
+		}
+	}
+
+	//Valor do fluxo maximo de s para t
+	long long resolver(const Grafo& grafo, int s, int t, Equipe& equipe){
+		int e;
+
+		r.construir(grafo);
+		n = r.n;
+		m = r.m;
+		if(s == t) return 0;
+		rotulo.assign(n, n);
+		novo.assign(n, n);
+		sobra.assign(n, 0);
+		recebido.reset(new atomic<long long>[n]);
+		marca.reset(new atomic<int>[n]);
+		visita.reset(new atomic<int>[n]);
+		for( int v = 0; v < n; v++ ){
+			recebido[v] = 0;
+			marca[v] = 0;
+			visita[v] = 0;
+		}
+		listas.assign(equipe.n, vector<int>());
+		contPush.assign(equipe.n, 0);
+		contRelabel.assign(equipe.n, 0);
+		contTrabalho.assign(equipe.n, 0);
+
+		//Satura as arestas que saem da origem
+		for( e = r.ini[s]; e < r.ini[s + 1]; e++ ){
+			if(r.res[e] > 0){
+				r.excesso[r.para[e]] += r.res[e];
+				r.excesso[s] -= r.res[e];
+				r.res[r.rev[e]] += r.res[e];
+				r.res[e] = 0;
+			}
+		}
+
+		//Fase 1: pre-fluxo maximo; Fase 2: excesso de volta para a origem
+		interrompido = false;
+		fase(t, s, equipe);
+		if(!interrompido) fase(s, t, equipe);
+
+		for( int id = 0; id < equipe.n; id++ ){
+			nPush += contPush[id];
+			nRelabel += contRelabel[id];
+		}
+		return r.excesso[t];
+	}
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*---------------- File: grafo.h  -----------------------+
+|Grafo esparso em formato CSR (Compressed Sparse Row)    |
+|					      		                        |
+| Estrela direta e reversa com os dados dos arcos em     |
+| colunas separadas (custo e capacidade). As colunas     |
+| podem apontar para um arquivo binario mapeado.         |
++-------------------------------------------------------+ */
+
+#ifndef GRAFO_H
+#define GRAFO_H
+
+#include <bits/stdc++.h>
+
+using namespace std;
+
+//Vetor que e dono dos dados ou vista de memoria externa (arquivo mapeado, ver binario.h)
+template<class T>
+struct Coluna {
+	vector<T> dados;	//usado quando a coluna e dona dos dados
+	T* p = nullptr;
+	size_t tam = 0;
+	bool vista = false;
+
+	Coluna(){}
+	Coluna(const Coluna& o){ *this = o; }
+	Coluna& operator=(const Coluna& o){
+		vista = o.vista;
+		tam = o.tam;
+		if(vista){
+			vector<T>().swap(dados);
+			p = o.p;
+		}else{
+			dados = o.dados;
+			p = dados.data();
+		}
+		return *this;
+	}
+
+	//Passa a ler e escrever direto em mem[0 .. n-1]
+	void apontar(T* mem, size_t n){
+		vector<T>().swap(dados);
+		p = mem;
+		tam = n;
+		vista = true;
+	}
+	void assign(size_t n, const T& v){
+		dados.assign(n, v);
+		p = dados.data();
+		tam = n;
+		vista = false;
+	}
+	//Numa vista o conteudo antigo nao e copiado: o mapeamento pode ja ter sido desfeito
+	void resize(size_t n){
+		if(vista) dados.clear();
+		dados.resize(n);
+		p = dados.data();
+		tam = n;
+		vista = false;
+	}
+
+	size_t size() const { return tam; }
+	T* data(){ return p; }
+	const T* data() const { return p; }
+	T* begin(){ return p; }
+	T* end(){ return p + tam; }
+	const T* begin() const { return p; }
+	const T* end() const { return p + tam; }
+	T& operator[](size_t i){ return p[i]; }
+	const T& operator[](size_t i) const { return p[i]; }
+};
+
+//Arcos na ordem em que foram lidos, antes da compressao
+struct ListaArcos {
+	vector<int> o, d;	//origem e destino
+	vector<int> custo, cap;	//custo (ou peso) e capacidade
+
+	void add(int origem, int destino, int w, int c){
+		o.push_back(origem);
+		d.push_back(destino);
+		custo.push_back(w);
+		cap.push_back(c);
+	}
+	int size() const { return o.size(); }
+};
+
+struct Grafo {
+	int n = 0;	//Quantidade de vertices de saida (linhas)
+	int nDest = 0;	//Quantidade de vertices de chegada (colunas), igual a n em grafos comuns
+	int m = 0;	//Quantidade de arcos
+
+	//Estrela direta: arcos de i sao [inicio[i], inicio[i+1]), em ordem de destino
+	Coluna<int> inicio;
+	Coluna<int> origem;
+	Coluna<int> destino;
+
+	//Estrela reversa: arcos que chegam em j sao arcoInv[inicioInv[j] .. inicioInv[j+1]-1], em ordem de origem
+	Coluna<int> inicioInv;
+	Coluna<int> arcoInv;
+
+	//Colunas dos arcos
+	Coluna<int> custo;	//custo (ou peso) do arco
+	Coluna<int> cap;	//capacidade do arco
+
+	//Comprime a lista (que e esvaziada). Arcos repetidos ficam com os dados da ultima leitura.
+	void montar(int nSaida, int nChegada, ListaArcos& lista){
+		int i, k, p;
+		int total = lista.size();
+
+		n = nSaida;
+		nDest = nChegada;
+
+		//Ordenacao estavel por (origem, destino) com duas passadas de contagem
+		vector<int> cont(max(n, nDest) + 1);
+		vector<int> porDestino(total), ordem(total);
+
+		for( k = 0; k < total; k++ ) cont[lista.d[k] + 1]++;
+		for( i = 0; i < nDest; i++ ) cont[i + 1] += cont[i];
+		for( k = 0; k < total; k++ ) porDestino[cont[lista.d[k]]++] = k;
+
+		fill(cont.begin(), cont.end(), 0);
+		for( k = 0; k < total; k++ ) cont[lista.o[k] + 1]++;
+		for( i = 0; i < n; i++ ) cont[i + 1] += cont[i];
+		for( k = 0; k < total; k++ ) ordem[cont[lista.o[porDestino[k]]]++] = porDestino[k];
+		vector<int>().swap(porDestino);
+
+		//Remove repeticoes mantendo a ultima leitura de cada (origem, destino)
+		m = 0;
+		for( k = 0; k < total; k++ ){
+			p = ordem[k];
+			if(k + 1 < total && lista.o[ordem[k + 1]] == lista.o[p] && lista.d[ordem[k + 1]] == lista.d[p]) continue;
+			ordem[m++] = p;
+		}
+
+		inicio.assign(n + 1, 0);
+		origem.resize(m);
+		destino.resize(m);
+		custo.resize(m);
+		cap.resize(m);
+		for( k = 0; k < m; k++ ){
+			p = ordem[k];
+			origem[k] = lista.o[p];
+			destino[k] = lista.d[p];
+			custo[k] = lista.custo[p];
+			cap[k] = lista.cap[p];
+			inicio[origem[k] + 1]++;
+		}
+		for( i = 0; i < n; i++ ) inicio[i + 1] += inicio[i];
+		vector<int>().swap(ordem);
+		lista = ListaArcos();
+
+		//Estrela reversa (contagem estavel por destino, logo em ordem de origem)
+		inicioInv.assign(nDest + 1, 0);
+		arcoInv.resize(m);
+		for( k = 0; k < m; k++ ) inicioInv[destino[k] + 1]++;
+		for( i = 0; i < nDest; i++ ) inicioInv[i + 1] += inicioInv[i];
+		vector<int> pos(inicioInv.begin(), inicioInv.end() - 1);
+		for( k = 0; k < m; k++ ) arcoInv[pos[destino[k]]++] = k;
+	}
+
+	//Descarta os arcos de capacidade zero (nao carregam fluxo e so aumentariam o modelo)
+	void removerSemCapacidade(){
+		ListaArcos lista;
+		for( int k = 0; k < m; k++ ){
+			if(cap[k] != 0) lista.add(origem[k], destino[k], custo[k], cap[k]);
+		}
+		if(lista.size() != m) montar(n, nDest, lista);
+	}
+
+	//Indice do arco (i, j), ou -1 se nao existe
+	int arco(int i, int j) const {
+		auto ini = destino.begin() + inicio[i];
+		auto fim = destino.begin() + inicio[i + 1];
+		auto it = lower_bound(ini, fim, j);
+		if(it == fim || *it != j) return -1;
+		return it - destino.begin();
+	}
+};
+
+#endif
@@ -0,0 +1,248 @@
+/*---------------- File: k_melhores.h  ------------------+
+|Designacao - K melhores solucoes (ranking de Murty)     |
+|					      		                        |
+| Cada solucao emitida particiona o que sobrou do seu    |
+| espaco em subproblemas (linhas fixas + um par          |
+| proibido), avaliados em paralelo a partir dos duais    |
+| dela: um Dijkstra por subproblema.                     |
++-------------------------------------------------------+ */
+
+#ifndef K_MELHORES_H
+#define K_MELHORES_H
+
+#include <bits/stdc++.h>
+#include "designacao.h"
+#include "paralelo.h"
+
+using namespace std;
+
+/*
+* Filha t de uma solucao S: as t primeiras linhas livres de S ficam fixas (com a coluna de S)
+* e o par da linha livre r = livres[t] e proibido. Os duais de S continuam viaveis na filha
+* (ela so tira pares), e o par de r era tight: o custo otimo da filha e custo(S) + a
+* distancia reduzida de r ate a coluna c que r deixou. Em instancias retangulares as colunas
+* livres sao vistas como tomadas por linhas ficticias de custo 0 (todas com u = 0): a busca
+* que chega numa coluna livre segue uma vez para todas as colunas com custo reduzido -v.
+* So o custo da filha vai para a fila; a solucao e refeita se ela for emitida: nas quadradas
+* a partir dos duais da raiz (tambem viaveis), aumentando so as linhas que perderam o par; nas
+* retangulares do zero, porque as colunas que ficam livres precisam de v = 0.
+*/
+struct KMelhores {
+	static constexpr long long INF = DesignacaoEsparsa::INF;
+
+	//Solucao emitida e a particao de onde saiu
+	struct Solucao {
+		long long custo;
+		vector<int> col;	//coluna de cada linha
+		vector<int> fixas;	//linhas fixadas na particao
+		vector<int> proibidos;	//pares proibidos na particao
+	};
+	//Particao ainda nao emitida: filha t da solucao pai
+	struct Candidata {
+		long long custo;
+		int pai, t;
+		bool operator<(const Candidata& o) const { return tie(custo, pai, t) < tie(o.custo, o.pai, o.t); }
+	};
+	//Area de cada thread para os Dijkstras das filhas
+	struct Busca {
+		vector<long long> dist;
+		vector<char> fechada;
+		vector<int> tocadas;
+		HeapBinario heap;
+	};
+
+	const ParesDesignacao* p = nullptr;
+	DesignacaoEsparsa raiz;	//estado otimo do problema inteiro
+	int k = 1;
+	vector<Solucao> solucoes;	//em ordem de custo
+	long long nFilhas = 0;	//particoes avaliadas
+
+	//Cancelamento cooperativo: consultado a cada solucao emitida
+	const atomic<bool>* parar = nullptr;
+	bool interrompido = false;
+
+	KMelhores(const ParesDesignacao& pares) : p(&pares) {}
+
+	//Resolve a particao (fixas, proibidos); as fixas ficam com as colunas de base
+	bool resolverParticao(DesignacaoEsparsa& d, const Solucao& s, const vector<int>& base){
+		const ParesDesignacao& P = *p;
+
+		d.proibido.assign(P.para.size(), 0);
+		d.fixa.assign(P.n, 0);
+		d.presa.assign(P.m, 0);
+		for( int q : s.proibidos ) d.proibido[q] = 1;
+		for( int i : s.fixas ){
+			d.fixa[i] = 1;
+			d.presa[base[i]] = 1;
+		}
+		if(raiz.col.empty() || P.n < P.m){
+			if(!d.resolver()) return false;
+		}
+		else{
+			//Quadrada: cada linha ativa fica com a coluna da raiz, se o par continua usavel
+			d.interrompido = false;
+			d.col = raiz.col;
+			d.u = raiz.u;
+			d.v = raiz.v;
+			d.lin.assign(P.m, -1);
+			for( int i = 0; i < P.n; i++ ){
+				if(!d.ativa(i) || d.presa[d.col[i]] || d.proibido[P.par(i, d.col[i])]) d.col[i] = -1;
+				else d.lin[d.col[i]] = i;
+			}
+			if(!d.completar()) return false;
+		}
+		for( int i : s.fixas ){
+			d.col[i] = base[i];
+			d.lin[base[i]] = i;
+		}
+		return true;
+	}
+
+	//Custo otimo da filha t de S (estado d, com as mascaras de S), a mais que o de S; INF se a
+	//filha nao tem solucao ou se passa de corte (lido a cada coluna fechada: so desce). pos[i]
+	//e a posicao da linha i entre as livres de S (-1 nas fixas).
+	long long filha(Busca& b, const DesignacaoEsparsa& d, const vector<int>& pos, int r, int t, const atomic<long long>& corte){
+		const ParesDesignacao& P = *p;
+		int j, c = d.col[r];
+		long long dj, res = INF;
+		bool ficticias = P.n < P.m;	//as linhas ficticias ainda nao foram seguidas
+
+		//Coluna fora da filha: de uma linha fixa em S ou de uma das t primeiras livres
+		auto presa = [&](int col){ return d.lin[col] >= 0 && pos[d.lin[col]] < t; };
+		auto relaxar = [&](int col, long long w){
+			if(b.fechada[col] || w >= b.dist[col]) return;
+			if(b.dist[col] == INF) b.tocadas.push_back(col);
+			b.dist[col] = w;
+			b.heap.push(w, col);
+		};
+		auto linha = [&](int i, long long di){
+			for( int q = P.ini[i]; q < P.ini[i + 1]; q++ ){
+				int col = P.para[q];
+				if((i == r && col == c) || d.proibido[q] || presa(col)) continue;
+				relaxar(col, di + P.custo[q] - d.u[i] - d.v[col]);
+			}
+		};
+
+		if(b.dist.size() != (size_t)P.m){
+			b.dist.assign(P.m, INF);
+			b.fechada.assign(P.m, 0);
+		}
+		b.heap.clear();
+		linha(r, 0);
+		while(true){
+			for( j = -1; j < 0 && !b.heap.empty(); ){
+				tie(dj, j) = b.heap.pop();
+				if(b.fechada[j] || dj != b.dist[j]) j = -1;
+			}
+			if(j < 0 || dj > corte.load(memory_order_relaxed)) break;
+			b.fechada[j] = 1;
+			if(j == c){
+				res = dj;
+				break;
+			}
+			if(d.lin[j] >= 0) linha(d.lin[j], dj);
+			else if(ficticias){
+				//Todas as ficticias tem as mesmas arestas: basta a primeira alcancada
+				ficticias = false;
+				for( int col = 0; col < P.m; col++ ) if(!presa(col)) relaxar(col, dj - d.v[col]);
+			}
+		}
+		for( int col : b.tocadas ){
+			b.dist[col] = INF;
+			b.fechada[col] = 0;
+		}
+		b.tocadas.clear();
+		return res;
+	}
+
+	//As k melhores designacoes distintas (menos, se o espaco acabar antes)
+	void resolver(Equipe& equipe){
+		const ParesDesignacao& P = *p;
+		DesignacaoEsparsa d(P);
+		vector<Busca> buscas(equipe.n);
+		vector<int> pos(P.n), livres;
+		set<Candidata> fila;
+		Solucao s;
+		bool ok;
+
+		interrompido = false;
+		solucoes.clear();
+		d.parar = parar;
+		//Raiz: o problema inteiro
+		raiz = DesignacaoEsparsa(P);
+		ok = resolverParticao(d, s, s.col);
+		if(ok) raiz = d;
+		while(ok){
+			s.col = d.col;
+			s.custo = P.total(d.col);
+			solucoes.push_back(s);
+			if((int)solucoes.size() >= k) break;
+
+			//Filhas da solucao emitida, em paralelo a partir dos duais dela
+			int pai = solucoes.size() - 1;
+			livres.clear();
+			for( int i = 0; i < P.n; i++ ){
+				pos[i] = d.fixa[i] ? -1 : livres.size();
+				if(!d.fixa[i]) livres.push_back(i);
+			}
+			//Corte: a (k - emitidas)-esima menor entre a fila e as filhas ja avaliadas. Filha acima
+			//dele nao entra; como ele so desce, as que entram saem exatas com qualquer ordem de threads
+			size_t resta = k - solucoes.size();
+			long long custoPai = solucoes[pai].custo;
+			priority_queue<long long> menores;
+			mutex trava;
+			atomic<long long> corte(INF);
+			auto guardar = [&](long long custo){
+				menores.push(custo);
+				if(menores.size() > resta) menores.pop();
+				if(menores.size() == resta) corte = min(corte.load(), menores.top() - custoPai);
+			};
+			//Na fila, o empate com a ultima ja fica de fora (pai maior)
+			for( const Candidata& c : fila ) guardar(c.custo);
+			if(menores.size() == resta) corte = corte - 1;
+			vector<long long> custos(livres.size());
+			equipe.paraCada(livres.size(), [&](int ini, int fim, int id){
+				for( int t = ini; t < fim; t++ ){
+					custos[t] = filha(buscas[id], d, pos, livres[t], t, corte);
+					if(custos[t] == INF) continue;
+					lock_guard<mutex> g(trava);
+					guardar(custoPai + custos[t]);
+				}
+			});
+			nFilhas += livres.size();
+			for( int t = 0; t < (int)livres.size(); t++ ){
+				if(custos[t] < INF) fila.insert({solucoes[pai].custo + custos[t], pai, t});
+			}
+			//So as k - emitidas primeiras ainda podem sair
+			while(fila.size() > k - solucoes.size()) fila.erase(prev(fila.end()));
+			if(parar != nullptr && parar->load(memory_order_relaxed)){
+				interrompido = true;
+				return;
+			}
+
+			//Proxima: a particao de menor custo, refeita do zero com as restricoes dela
+			ok = false;
+			while(!ok && !fila.empty() && !d.interrompido){
+				Candidata c = *fila.begin();
+				fila.erase(fila.begin());
+				const Solucao& S = solucoes[c.pai];
+				vector<char> fixaPai(P.n, 0);
+				for( int i : S.fixas ) fixaPai[i] = 1;
+				s = Solucao();
+				s.fixas = S.fixas;
+				s.proibidos = S.proibidos;
+				int r = -1;
+				for( int i = 0, t = 0; i < P.n && r < 0; i++ ){
+					if(fixaPai[i]) continue;
+					if(t++ < c.t) s.fixas.push_back(i);
+					else r = i;
+				}
+				s.proibidos.push_back(P.par(r, S.col[r]));
+				ok = resolverParticao(d, s, S.col);
+			}
+		}
+		interrompido = d.interrompido;
+	}
+};
+
+#endif
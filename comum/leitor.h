@@ -0,0 +1,143 @@
+/*---------------- File: leitor.h  ----------------------+
+|Leitura rapida das instancias em texto                  |
+|					      		                        |
+| Le a entrada em blocos grandes e converte os inteiros  |
+| a mao, contando as linhas. Erros de formato e ids fora |
+| do intervalo saem no stderr com o numero da linha.     |
++-------------------------------------------------------+ */
+
+#ifndef LEITOR_H
+#define LEITOR_H
+
+#include <bits/stdc++.h>
+
+using namespace std;
+
+struct Leitor {
+	static constexpr size_t BLOCO = 1 << 20;
+
+	istream& in;
+	string nome;	//nome da instancia nas mensagens
+	unique_ptr<char[]> buf;	//sem inicializar: so as paginas lidas sao tocadas
+	size_t pos = 0, tam = 0;
+	long long linha = 1;	//linha do proximo caractere
+	long long linhaRegistro = 0;	//linha do ultimo registro lido
+	bool erro = false;
+
+	Leitor(istream& entrada, const string& nomeInstancia) : in(entrada), nome(nomeInstancia), buf(new char[BLOCO]) {}
+
+	//Proximo caractere sem consumir (EOF no fim da entrada)
+	int espiar(){
+		if(pos == tam){
+			if(!in) return EOF;
+			in.read(buf.get(), BLOCO);
+			tam = in.gcount();
+			pos = 0;
+			if(tam == 0) return EOF;
+		}
+		return (unsigned char)buf[pos];
+	}
+	void avancar(){
+		if(buf[pos++] == '\n') linha++;
+	}
+
+	bool falha(long long l, const char* fmt, ...){
+		va_list args;
+		if(erro) return false;
+		erro = true;
+		fprintf(stderr, "%s:%lld: ", nome.c_str(), l);
+		va_start(args, fmt);
+		vfprintf(stderr, fmt, args);
+		va_end(args);
+		fputc('\n', stderr);
+		return false;
+	}
+
+	//Pula espacos; com linhas = false para no fim da linha
+	int pular(bool linhas){
+		int ch;
+		while((ch = espiar()) != EOF){
+			if(ch == ' ' || ch == '\t' || ch == '\r' || (linhas && ch == '\n')) avancar();
+			else break;
+		}
+		return ch;
+	}
+
+	//Entrada sem nenhum inteiro (so espacos e linhas em branco)
+	bool vazio(){ return pular(true) == EOF; }
+
+	//Converte o inteiro que comeca na posicao atual (depois de pular os espacos)
+	bool numero(int& v){
+		long long l = linha, r = 0;
+		bool neg = false;
+		int ch = espiar(), dig = 0;
+
+		if(ch == '-' || ch == '+'){
+			neg = ch == '-';
+			avancar();
+			ch = espiar();
+		}
+		while(ch >= '0' && ch <= '9'){
+			r = r * 10 + (ch - '0');
+			if(r > INT_MAX) return falha(l, "inteiro fora do intervalo de 32 bits");
+			avancar();
+			dig++;
+			ch = espiar();
+		}
+		if(dig == 0 || (ch != EOF && ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n')){
+			string token = string(neg ? "-" : "") + (dig ? to_string(r) : "");
+			while(ch != EOF && ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n' && token.size() < 32){
+				token += (char)ch;
+				avancar();
+				ch = espiar();
+			}
+			return falha(l, "esperado um inteiro, lido \"%s\"", token.c_str());
+		}
+		v = neg ? -r : r;
+		return true;
+	}
+
+	//Proximo inteiro, em qualquer linha (cabecalho). Falso no fim da entrada ou em erro.
+	bool inteiro(int& v){
+		if(erro || pular(true) == EOF) return false;
+		return numero(v);
+	}
+
+	//Inteiro obrigatorio do cabecalho: o fim da entrada tambem e erro
+	bool campo(int& v, const char* oque){
+		if(inteiro(v)) return true;
+		if(!erro) falha(linha, "fim da entrada lendo %s", oque);
+		return false;
+	}
+
+	//Proximo registro de n inteiros numa mesma linha (linhas em branco sao puladas).
+	//Falso no fim da entrada; registro incompleto ou com inteiros a mais e erro.
+	bool registro(int* v, int n){
+		int i, ch;
+		if(erro || pular(true) == EOF) return false;
+		linhaRegistro = linha;
+		for( i = 0; i < n; i++ ){
+			ch = pular(false);
+			if(ch == EOF || ch == '\n') return falha(linhaRegistro, "registro incompleto: esperados %d inteiros, lidos %d", n, i);
+			if(!numero(v[i])) return false;
+		}
+		ch = pular(false);
+		if(ch != EOF && ch != '\n') return falha(linhaRegistro, "registro com mais de %d inteiros", n);
+		return true;
+	}
+
+	//Confere 0 <= v < lim no ultimo registro lido
+	bool intervalo(int v, int lim, const char* oque){
+		if(v >= 0 && v < lim) return true;
+		return falha(linhaRegistro ? linhaRegistro : linha, "%s %d fora do intervalo [0, %d)", oque, v, lim);
+	}
+
+	//Quantidade do cabecalho: nao pode ser negativa
+	bool quantidade(int& v, const char* oque){
+		if(!campo(v, oque)) return false;
+		if(v < 0) return falha(linha, "%s negativa: %d", oque, v);
+		return true;
+	}
+};
+
+#endif
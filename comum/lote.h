@@ -0,0 +1,102 @@
+/*---------------- File: lote.h  ------------------------+
+|Modo lote - varias instancias por processo              |
+|					      		                        |
+| As instancias vem dos arquivos/diretorios passados na  |
+| linha de comando ou de stdin, separadas por linhas     |
+| "---". Cada instancia sai como um registro separado.   |
++-------------------------------------------------------+ */
+
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <bits/stdc++.h>
+
+using namespace std;
+
+struct Lote {
+	bool ativo = false;	//--batch ou caminhos na linha de comando
+	vector<string> arquivos;	//arquivos na ordem de resolucao (diretorios ja expandidos)
+	size_t prox = 0;
+	int contador = 0;	//instancias entregues ate agora
+	string nome;	//nome da instancia atual
+	ifstream arquivo;
+	istringstream bloco;
+
+	//Diretorios contribuem com seus arquivos regulares, em ordem alfabetica
+	void adicionar(const string& caminho){
+		ativo = true;
+		if(filesystem::is_directory(caminho)){
+			vector<string> dentro;
+			for( auto& e : filesystem::directory_iterator(caminho) ){
+				if(e.is_regular_file()) dentro.push_back(e.path().string());
+			}
+			sort(dentro.begin(), dentro.end());
+			arquivos.insert(arquivos.end(), dentro.begin(), dentro.end());
+		}else{
+			arquivos.push_back(caminho);
+		}
+	}
+
+	static bool separador(const string& linha){
+		size_t a = linha.find_first_not_of(" \t\r");
+		size_t b = linha.find_last_not_of(" \t\r");
+		return a != string::npos && linha.compare(a, b - a + 1, "---") == 0;
+	}
+
+	//Proxima instancia a ler, ou nullptr no fim. Fora do modo lote entrega stdin uma vez.
+	istream* proxima(){
+		if(!ativo){
+			if(contador++ > 0) return nullptr;
+			nome = "stdin";
+			return &cin;
+		}
+
+		//Sem caminhos: blocos de stdin entre linhas "---" (blocos vazios sao ignorados)
+		if(arquivos.empty()){
+			string linha, texto;
+			bool conteudo = false;
+			while(getline(cin, linha)){
+				if(separador(linha)){
+					if(conteudo) break;
+					continue;
+				}
+				if(linha.find_first_not_of(" \t\r") != string::npos) conteudo = true;
+				texto += linha;
+				texto += '\n';
+			}
+			if(!conteudo) return nullptr;
+			bloco.clear();
+			bloco.str(texto);
+			nome = "stdin#" + to_string(++contador);
+			return &bloco;
+		}
+
+		while(prox < arquivos.size()){
+			nome = arquivos[prox++];
+			arquivo.close();
+			arquivo.clear();
+			arquivo.open(nome);
+			if(!arquivo){
+				fprintf(stderr, "Nao foi possivel abrir %s\n", nome.c_str());
+				continue;
+			}
+			contador++;
+			return &arquivo;
+		}
+		return nullptr;
+	}
+
+	//Arquivo da instancia atual, para quem quer abri-lo de novo (ex.: formato binario).
+	//Blocos de stdin nao tem arquivo; fora do modo lote stdin pode ser um arquivo redirecionado.
+	string caminho() const {
+		if(!ativo) return "/dev/stdin";
+		return arquivos.empty() ? "" : nome;
+	}
+
+	//Cabecalho do registro de cada instancia (so no modo lote)
+	void cabecalho() const {
+		if(ativo) printf("==== Instancia %d: %s ====\n", contador, nome.c_str());
+	}
+};
+
+#endif
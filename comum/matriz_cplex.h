@@ -0,0 +1,122 @@
+/*---------------- File: matriz_cplex.h  ----------------+
+|Carga do modelo em bloco pela biblioteca do CPLEX       |
+|					      		                        |
+| A matriz e preenchida por colunas em vetores planos    |
+| (em paralelo, por quem monta o modelo) e entra de uma  |
+| vez com CPXcopylp, sem expressoes do Concert.          |
++-------------------------------------------------------+ */
+
+#ifndef MATRIZ_CPLEX_H
+#define MATRIZ_CPLEX_H
+
+#include <bits/stdc++.h>
+#include <ilcplex/cplex.h>
+#include "paralelo.h"
+#include "parametros_cplex.h"
+
+using namespace std;
+
+struct MatrizCplex {
+	CPXENVptr amb = nullptr;
+	CPXLPptr lp = nullptr;
+	int linhas = 0, colunas = 0, porColuna = 0;
+	volatile int* terminar = nullptr;	//CPXsetterminate: != 0 interrompe a otimizacao (corrida de motores)
+
+	//Coluna k: custo obj[k], limite superior ub[k] (vazio: sem limite) e as entradas
+	//indice/valor de inicio[k] a inicio[k] + porColuna - 1
+	vector<double> obj, ub, valor, rhs;
+	vector<int> inicio, quantos, indice, todas;
+	vector<char> sentido;
+
+	~MatrizCplex(){ fechar(); }
+
+	bool abrir(){
+		int erro;
+		if(amb == nullptr) amb = CPXopenCPLEX(&erro);
+		return amb != nullptr;
+	}
+	void liberar(){
+		if(lp != nullptr) CPXfreeprob(amb, &lp);
+		lp = nullptr;
+	}
+	void fechar(){
+		liberar();
+		if(amb != nullptr) CPXcloseCPLEX(&amb);
+		amb = nullptr;
+	}
+
+	//Vetores para nLinhas x nColunas com o mesmo numero de entradas por coluna (coeficientes 1)
+	void dimensionar(int nLinhas, int nColunas, int nPorColuna, bool comLimite, Equipe& equipe){
+		linhas = nLinhas;
+		colunas = nColunas;
+		porColuna = nPorColuna;
+		obj.resize(colunas);
+		ub.resize(comLimite ? colunas : 0);
+		inicio.resize(colunas);
+		quantos.resize(colunas);
+		indice.resize((size_t)colunas * porColuna);
+		valor.resize((size_t)colunas * porColuna);
+		rhs.resize(linhas);
+		sentido.resize(linhas);
+		equipe.paraCada(colunas, [&](int ini, int fim, int){
+			for( int k = ini; k < fim; k++ ){
+				inicio[k] = k * porColuna;
+				quantos[k] = porColuna;
+				for( int e = 0; e < porColuna; e++ ) valor[(size_t)k * porColuna + e] = 1;
+			}
+		});
+	}
+
+	//Copia o modelo para o CPLEX (CPXcopylp) e descarta a matriz, que o CPLEX ja guardou
+	bool carregar(int sentidoFO, bool inteiro){
+		if(!abrir()) return false;
+		liberar();
+		int erro;
+		lp = CPXcreateprob(amb, &erro, "modelo");
+		if(lp == nullptr) return false;
+		if(CPXcopylp(amb, lp, colunas, linhas, sentidoFO, obj.data(), rhs.data(), sentido.data(),
+			inicio.data(), quantos.data(), indice.data(), valor.data(), nullptr, ub.empty() ? nullptr : ub.data(), nullptr) != 0) return false;
+		if(inteiro){
+			vector<char> tipo(colunas, CPX_INTEGER);
+			if(CPXcopyctype(amb, lp, tipo.data()) != 0) return false;
+		}
+		vector<int>().swap(inicio);
+		vector<int>().swap(quantos);
+		vector<int>().swap(indice);
+		vector<double>().swap(valor);
+		vector<double>().swap(ub);
+		todas.resize(max(colunas, linhas));
+		iota(todas.begin(), todas.end(), 0);
+		return true;
+	}
+
+	//Mesma forma do modelo carregado: troca custos (obj) e lados direitos (rhs)
+	bool atualizar(){
+		return CPXchgobj(amb, lp, colunas, todas.data(), obj.data()) == 0 && CPXchgrhs(amb, lp, linhas, todas.data(), rhs.data()) == 0;
+	}
+
+	//Resolve com os parametros da execucao e log so se pedido; devolve o status da FO no formato do Concert
+	string resolver(const ParametrosCplex& parametros, bool log, bool& sol, double& fo, vector<double>& x){
+		int st, tipo, primal;
+		bool inteiro = CPXgetprobtype(amb, lp) == CPXPROB_MILP;
+
+		parametros.aplicar(amb);
+		CPXsetterminate(amb, terminar);
+		if(log) parametros.imprimir();
+		CPXsetintparam(amb, CPXPARAM_ScreenOutput, log ? CPX_ON : CPX_OFF);
+		if(inteiro) CPXmipopt(amb, lp);
+		else CPXlpopt(amb, lp);
+
+		st = CPXgetstat(amb, lp);
+		CPXsolninfo(amb, lp, nullptr, &tipo, &primal, nullptr);
+		sol = tipo != CPX_NO_SOLN && primal;
+		if(!sol) return "No Solution";
+		x.resize(colunas);
+		CPXgetobjval(amb, lp, &fo);
+		CPXgetx(amb, lp, x.data(), 0, colunas - 1);
+		if(st == CPX_STAT_OPTIMAL || st == CPXMIP_OPTIMAL || st == CPXMIP_OPTIMAL_TOL) return "Optimal";
+		return "Feasible";
+	}
+};
+
+#endif
@@ -0,0 +1,91 @@
+/*---------------- File: medicao.h  ---------------------+
+|Tempo por fase e pico de memoria de cada instancia      |
+|					      		                        |
+| Relogio monotonico (steady_clock) em nanossegundos.    |
+| Com --stats=arquivo cada instancia gera uma linha JSON |
+| com os tempos das fases e o pico de RSS ("-": stderr). |
++-------------------------------------------------------+ */
+
+#ifndef MEDICAO_H
+#define MEDICAO_H
+
+#include <bits/stdc++.h>
+#include <sys/resource.h>
+
+using namespace std;
+
+struct Medicao {
+	enum Fase { LEITURA, GRAFO, MODELO, EXTRACAO, RESOLUCAO, SOLUCAO, N_FASES };
+	static constexpr const char* NOMES[N_FASES] = {"leitura", "grafo", "modelo", "extracao", "resolucao", "solucao"};
+
+	long long ns[N_FASES];
+	long long memoriaSolver = -1;	//bytes alocados pelo solver (env.getMemoryUsage), -1 se nao houver
+	chrono::steady_clock::time_point marca;
+	string parametros;	//campos JSON extras do registro (parametros do CPLEX), vazio se nao houver
+	string arquivo;	//--stats=: destino das linhas JSON (vazio: desligado)
+	FILE* destino = nullptr;
+
+	Medicao(){ zerar(); }
+	~Medicao(){ if(destino != nullptr && destino != stderr) fclose(destino); }
+
+	void zerar(){
+		for( int f = 0; f < N_FASES; f++ ) ns[f] = 0;
+		memoriaSolver = -1;
+		marca = chrono::steady_clock::now();
+	}
+
+	//Inicio de uma fase; parar() soma o tempo desde a ultima marca e ja marca a proxima fase
+	void comecar(){ marca = chrono::steady_clock::now(); }
+	void parar(Fase f){
+		auto agora = chrono::steady_clock::now();
+		ns[f] += chrono::duration_cast<chrono::nanoseconds>(agora - marca).count();
+		marca = agora;
+	}
+
+	double segundos(Fase f) const { return ns[f] * 1e-9; }
+
+	//Fases medidas em outra thread (motor vencedor da corrida)
+	void somar(const Medicao& m){
+		for( int f = 0; f < N_FASES; f++ ) ns[f] += m.ns[f];
+		memoriaSolver = m.memoriaSolver;
+	}
+
+	//Pico de memoria residente do processo (ru_maxrss vem em KB no Linux)
+	static long long picoRSS(){
+		struct rusage uso;
+		getrusage(RUSAGE_SELF, &uso);
+		return (long long)uso.ru_maxrss * 1024;
+	}
+	static double mb(long long bytes){ return bytes / (1024. * 1024.); }
+
+	//Resumo legivel (modo texto detalhado)
+	void imprimir() const {
+		printf("Tempos (ms):");
+		for( int f = 0; f < N_FASES; f++ ) printf(" %s %.3lf%s", NOMES[f], ns[f] * 1e-6, f + 1 < N_FASES ? " -" : "");
+		printf("\nPico de memoria (RSS): %.1lf MB\n\n", mb(picoRSS()));
+	}
+
+	//Registro estruturado da instancia (uma linha JSON), se --stats foi pedido
+	bool abrir(){
+		if(arquivo.empty()) return true;
+		destino = arquivo == "-" ? stderr : fopen(arquivo.c_str(), "a");
+		return destino != nullptr;
+	}
+	void registrar(const string& instancia, const string& motor, const string& status){
+		if(destino == nullptr) return;
+		string nome;
+		for( char c : instancia ){
+			if(c == '"' || c == '\\') nome += '\\';
+			nome += c;
+		}
+		fprintf(destino, "{\"instancia\":\"%s\",\"motor\":\"%s\",\"status\":\"%s\"", nome.c_str(), motor.c_str(), status.c_str());
+		for( int f = 0; f < N_FASES; f++ ) fprintf(destino, ",\"%s_ns\":%lld", NOMES[f], ns[f]);
+		fprintf(destino, ",\"pico_rss_bytes\":%lld", picoRSS());
+		if(memoriaSolver >= 0) fprintf(destino, ",\"memoria_solver_bytes\":%lld", memoriaSolver);
+		if(!parametros.empty()) fprintf(destino, ",%s", parametros.c_str());
+		fprintf(destino, "}\n");
+		fflush(destino);
+	}
+};
+
+#endif
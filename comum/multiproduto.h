@@ -0,0 +1,184 @@
+/*---------------- File: multiproduto.h  ----------------+
+|Fluxo Multiproduto - Relaxacao Lagrangiana              |
+|					      		                        |
+| As capacidades conjuntas entram na funcao objetivo com |
+| multiplicadores; cada produto vira um fluxo de custo   |
+| minimo independente, resolvido em paralelo.            |
++-------------------------------------------------------+ */
+
+#ifndef MULTIPRODUTO_H
+#define MULTIPRODUTO_H
+
+#include <bits/stdc++.h>
+#include "custo_minimo.h"
+#include "paralelo.h"
+
+using namespace std;
+
+struct MultiProduto {
+	enum Status { OTIMO, VIAVEL, SEM_SOLUCAO, INVIAVEL };
+
+	//Os subproblemas trabalham em milesimos: multiplicadores fracionarios com custos inteiros
+	static constexpr long long ESCALA = 1000;
+
+	//Uma rede por produto; os arcos 0..m-1 de todas sao os mesmos arcos compartilhados,
+	//com a capacidade conjunta em cap. Os demais arcos sao proprios de cada produto.
+	int m = 0;
+	vector<CustoMinimo> redes;
+
+	//Parametros
+	int maxIteracoes = 300;
+	int periodoReparo = 10;	//iteracoes entre duas tentativas da heuristica de reparo
+
+	//Resultado
+	double limite = -numeric_limits<double>::infinity();	//melhor limite inferior (dual lagrangiano)
+	long long melhorCusto = CustoMinimo::INF;	//custo da melhor solucao viavel
+	vector<vector<long long>> melhor;	//fluxo de cada produto nos arcos compartilhados
+	vector<long long> custoProduto;	//custo de cada produto na melhor solucao
+	int iteracoes = 0;
+	long long nPivos = 0;
+
+	vector<long long> custo, cap;	//custo original e capacidade conjunta dos arcos compartilhados
+	vector<double> lambda;	//multiplicadores das capacidades conjuntas (>= 0)
+	vector<long long> lambdaEsc;	//lambda arredondado na escala dos subproblemas
+
+	int produtos() const { return redes.size(); }
+
+	//Custo original dos fluxos de um produto (sem os multiplicadores)
+	long long custoReal(const CustoMinimo& r) const {
+		long long total = 0;
+		for( int e = 0; e < m; e++ ) total += custo[e] * r.fluxo[e];
+		for( int e = m; e < r.m; e++ ) total += r.custo[e] / ESCALA * r.fluxo[e];
+		return total;
+	}
+
+	//Guarda os fluxos atuais das redes como solucao viavel, se forem melhores
+	void guardar(const vector<CustoMinimo>& rs){
+		vector<long long> custos(rs.size());
+		long long total = 0;
+		for( size_t k = 0; k < rs.size(); k++ ){
+			custos[k] = custoReal(rs[k]);
+			total += custos[k];
+		}
+		if(total >= melhorCusto) return;
+		melhorCusto = total;
+		custoProduto = custos;
+		for( size_t k = 0; k < rs.size(); k++ ) melhor[k].assign(rs[k].fluxo.begin(), rs[k].fluxo.begin() + m);
+	}
+
+	//Heuristica de reparo: produtos um a um, do maior fluxo para o menor, na capacidade que
+	//sobrou dos anteriores, com os custos lagrangianos atuais (evitam os arcos disputados)
+	bool reparar(){
+		vector<long long> resto = cap, volume(produtos(), 0);
+		vector<CustoMinimo> rs;
+		vector<int> ordem(produtos());
+		int k, e;
+
+		for( k = 0; k < produtos(); k++ ) for( e = 0; e < m; e++ ) volume[k] += redes[k].fluxo[e];
+		iota(ordem.begin(), ordem.end(), 0);
+		stable_sort(ordem.begin(), ordem.end(), [&](int a, int b){ return volume[a] > volume[b]; });
+		rs.resize(produtos());
+		for( int q : ordem ){
+			CustoMinimo& r = rs[q];
+			r = redes[q];
+			r.nPivos = 0;
+			for( e = 0; e < m; e++ ) r.cap[e] = resto[e];
+			bool ok = r.resolver() == CustoMinimo::OTIMO;
+			nPivos += r.nPivos;
+			if(!ok) return false;
+			for( e = 0; e < m; e++ ) resto[e] -= r.fluxo[e];
+		}
+		guardar(rs);
+		return true;
+	}
+
+	//Subgradiente com passo de Polyak sobre as capacidades conjuntas
+	Status resolver(Equipe& equipe){
+		int k, e, semMelhora = 0;
+		double theta = 2;
+		atomic<bool> inviavel(false);
+
+		custo.resize(m);
+		cap.resize(m);
+		for( e = 0; e < m; e++ ){
+			custo[e] = redes[0].custo[e];
+			cap[e] = redes[0].cap[e];
+		}
+		for( CustoMinimo& r : redes ){
+			for( e = 0; e < r.m; e++ ) r.custo[e] *= ESCALA;
+		}
+		lambda.assign(m, 0);
+		lambdaEsc.assign(m, 0);
+		melhor.assign(produtos(), vector<long long>());
+		vector<long long> soma(m);
+		vector<double> sub(m);
+
+		for( iteracoes = 0; iteracoes < maxIteracoes; iteracoes++ ){
+			//Subproblemas: da segunda iteracao em diante so os custos mudam, entao cada
+			//produto continua da propria arvore (alterarArco + reotimizar)
+			equipe.executar([&](int id){
+				for( int q = id; q < produtos(); q += equipe.n ){
+					CustoMinimo& r = redes[q];
+					if(iteracoes == 0){
+						if(r.resolver() != CustoMinimo::OTIMO) inviavel = true;
+						continue;
+					}
+					for( int a = 0; a < m; a++ ){
+						long long w = custo[a] * ESCALA + lambdaEsc[a];
+						if(w != r.custo[a]) r.alterarArco(a, r.cap[a], w);
+					}
+					if(r.reotimizar() != CustoMinimo::OTIMO) inviavel = true;
+				}
+			});
+			//Um produto sozinho ja nao cabe nas capacidades: o conjunto tambem nao
+			if(inviavel) return INVIAVEL;
+
+			//Limite inferior L(lambda) = soma dos custos lagrangianos - lambda . cap
+			double valor = 0;
+			fill(soma.begin(), soma.end(), 0);
+			for( k = 0; k < produtos(); k++ ){
+				valor += redes[k].custoTotal();
+				for( e = 0; e < m; e++ ) soma[e] += redes[k].fluxo[e];
+			}
+			bool cabe = true;
+			for( e = 0; e < m; e++ ){
+				valor -= (double)lambdaEsc[e] * cap[e];
+				if(soma[e] > cap[e]) cabe = false;
+			}
+			valor /= ESCALA;
+			if(valor > limite + 1e-9){
+				limite = valor;
+				semMelhora = 0;
+			}
+			else if(++semMelhora >= 10){
+				theta /= 2;
+				semMelhora = 0;
+			}
+
+			if(cabe) guardar(redes);
+			else if(iteracoes % periodoReparo == 0) reparar();
+			//Custos inteiros: o otimo inteiro nao fica abaixo do teto do limite
+			if(melhorCusto < CustoMinimo::INF && ceil(limite - 1e-6) >= melhorCusto) break;
+
+			//Subgradiente projetado (multiplicador em zero nao desce)
+			double norma = 0;
+			for( e = 0; e < m; e++ ){
+				sub[e] = soma[e] - cap[e];
+				if(lambda[e] <= 0 && sub[e] < 0) sub[e] = 0;
+				norma += sub[e] * sub[e];
+			}
+			if(norma == 0 || theta < 1e-4) break;
+			double alvo = melhorCusto < CustoMinimo::INF ? (double)melhorCusto : valor + max(1.0, fabs(valor) * 0.05);
+			double passo = theta * max(alvo - valor, 1e-3) / norma;
+			for( e = 0; e < m; e++ ){
+				lambda[e] = max(0.0, lambda[e] + passo * sub[e]);
+				lambdaEsc[e] = llround(lambda[e] * ESCALA);
+			}
+		}
+		for( CustoMinimo& r : redes ) nPivos += r.nPivos;
+		if(melhorCusto == CustoMinimo::INF && !reparar()) return SEM_SOLUCAO;
+		return ceil(limite - 1e-6) >= melhorCusto ? OTIMO : VIAVEL;
+	}
+};
+
+#endif
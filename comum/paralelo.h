@@ -0,0 +1,92 @@
+/*---------------- File: paralelo.h  --------------------+
+|Equipe fixa de threads para lacos paralelos             |
+|					      		                        |
+| As threads sao criadas uma vez e reutilizadas a cada   |
+| chamada de executar(), evitando criar threads por      |
+| rodada nos algoritmos iterativos.                      |
++-------------------------------------------------------+ */
+
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <bits/stdc++.h>
+
+using namespace std;
+
+//Quantidade padrao de threads (--threads=0 ou ausente)
+inline int threadsPadrao(){
+	unsigned h = thread::hardware_concurrency();
+	return h == 0 ? 1 : (int)h;
+}
+
+struct Equipe {
+	int n;	//Quantidade de threads, contando quem chama executar()
+	vector<thread> trabalhadores;
+	mutex mtx;
+	condition_variable cvInicio, cvFim;
+	function<void(int)> tarefa;
+	long long geracao = 0;
+	int pendentes = 0;
+	bool fim = false;
+
+	explicit Equipe(int nThreads) : n(max(1, nThreads)) {
+		for( int t = 1; t < n; t++ ) trabalhadores.emplace_back(&Equipe::laco, this, t);
+	}
+
+	~Equipe(){
+		{
+			lock_guard<mutex> lk(mtx);
+			fim = true;
+		}
+		cvInicio.notify_all();
+		for( auto& t : trabalhadores ) t.join();
+	}
+
+	//Executa f(id) em todas as threads (id 0 e a thread atual) e espera todas terminarem
+	void executar(const function<void(int)>& f){
+		if(n == 1){
+			f(0);
+			return;
+		}
+		{
+			lock_guard<mutex> lk(mtx);
+			tarefa = f;
+			pendentes = n - 1;
+			geracao++;
+		}
+		cvInicio.notify_all();
+		f(0);
+		unique_lock<mutex> lk(mtx);
+		cvFim.wait(lk, [&]{ return pendentes == 0; });
+	}
+
+	//Divide [0, total) em blocos contiguos, um por thread: f(ini, fim, id)
+	void paraCada(int total, const function<void(int, int, int)>& f){
+		executar([&](int id){
+			int ini = (long long)total * id / n;
+			int fim = (long long)total * (id + 1) / n;
+			if(ini < fim) f(ini, fim, id);
+		});
+	}
+
+	void laco(int id){
+		long long vista = 0;
+		function<void(int)> f;
+		while(true){
+			{
+				unique_lock<mutex> lk(mtx);
+				cvInicio.wait(lk, [&]{ return fim || geracao != vista; });
+				if(fim) return;
+				vista = geracao;
+				f = tarefa;
+			}
+			f(id);
+			{
+				lock_guard<mutex> lk(mtx);
+				if(--pendentes == 0) cvFim.notify_one();
+			}
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,143 @@
+/*---------------- File: parametros_cplex.h  ------------+
+|Parametros do CPLEX escolhidos na execucao              |
+|					      		                        |
+| --cplex-<chave>=valor na linha de comando ou linhas    |
+| chave=valor em --cplex-config=arquivo. Valem para o    |
+| Concert e para a carga em bloco (matriz_cplex.h).      |
++-------------------------------------------------------+ */
+
+#ifndef PARAMETROS_CPLEX_H
+#define PARAMETROS_CPLEX_H
+
+#include <bits/stdc++.h>
+#ifndef SEM_CPLEX
+#include <ilcplex/ilocplex.h>
+#endif
+
+using namespace std;
+
+//CPLEX Parameters
+#define CPLEX_TIME_LIM 3600 //3600 segundos (padrao de --cplex-timelimit)
+/*
+* Chaves:
+* timelimit=S   limite de tempo em segundos
+* threads=N     threads do CPLEX (0: o CPLEX decide)
+* parallel=     auto, deterministic ou opportunistic
+* lpmethod=     auto, primal, dual, network, barrier, sifting ou concurrent
+*               (algoritmo do LP, ou da raiz no MIP)
+* workmem=MB    memoria de trabalho (0: padrao do CPLEX, 2048)
+* treemem=MB    limite da arvore de branch-and-bound (0: sem limite)
+* varsel=M      selecao da variavel de branching
+*
+* VarSel Modes:
+* -1 Branch on variable with minimum infeasibility
+* 0 Branch variable automatically selected
+* 1 Branch on variable with maximum infeasibility
+* 2 Branch based on pseudo costs
+* 3 Strong branching
+* 4 Branch based on pseudo reduced costs
+*
+* Default: 0
+*/
+
+struct ParametrosCplex {
+	static constexpr const char* PARALELO[3] = {"opportunistic", "auto", "deterministic"};	//-1, 0, 1
+	static constexpr const char* METODOS[7] = {"auto", "primal", "dual", "network", "barrier", "sifting", "concurrent"};	//CPX_ALG_*
+
+	double tempo = CPLEX_TIME_LIM;
+	int threads = 0;
+	int paralelo = 0;
+	int metodo = 0;
+	double memoria = 0;	//WorkMem em MB (0: nao muda)
+	double arvore = 0;	//TreLim em MB (0: nao muda)
+	int varsel = 0;
+	string erro;	//primeira chave ou valor invalido (vazio: tudo certo)
+
+	static int indice(const char* const* nomes, int n, const string& valor){
+		for( int i = 0; i < n; i++ ) if(valor == nomes[i]) return i;
+		return -1;
+	}
+
+	//chave=valor de um parametro; false (e erro preenchido) se a chave ou o valor nao valem
+	bool definir(const string& chave, const string& valor){
+		char* fim = nullptr;
+		double v = strtod(valor.c_str(), &fim);
+		bool numero = !valor.empty() && *fim == '\0';
+		int i;
+
+		if(chave == "parallel" && (i = indice(PARALELO, 3, valor)) >= 0) paralelo = i - 1;
+		else if(chave == "lpmethod" && (i = indice(METODOS, 7, valor)) >= 0) metodo = i;
+		else if(chave == "timelimit" && numero && v > 0) tempo = v;
+		else if(chave == "threads" && numero && v >= 0) threads = (int)v;
+		else if(chave == "workmem" && numero && v >= 0) memoria = v;
+		else if(chave == "treemem" && numero && v >= 0) arvore = v;
+		else if(chave == "varsel" && numero && v >= -1 && v <= 4) varsel = (int)v;
+		else{
+			if(erro.empty()) erro = chave + "=" + valor;
+			return false;
+		}
+		return true;
+	}
+
+	//Argumento sem o prefixo --cplex-: "chave=valor" ou "config=arquivo"
+	bool argumento(const string& arg){
+		size_t igual = arg.find('=');
+		if(igual == string::npos) return definir(arg, "");
+		if(arg.compare(0, igual, "config") == 0) return ler(arg.substr(igual + 1));
+		return definir(arg.substr(0, igual), arg.substr(igual + 1));
+	}
+
+	//Arquivo de configuracao: uma chave=valor por linha, # comenta o resto da linha
+	bool ler(const string& caminho){
+		ifstream in(caminho);
+		string linha;
+		if(!in){
+			if(erro.empty()) erro = "config=" + caminho + " (arquivo nao encontrado)";
+			return false;
+		}
+		while(getline(in, linha)){
+			linha = linha.substr(0, linha.find('#'));
+			linha.erase(remove_if(linha.begin(), linha.end(), ::isspace), linha.end());
+			if(!linha.empty() && !argumento(linha)) return false;
+		}
+		return true;
+	}
+
+	//Campos do registro de --stats (JSON, sem as chaves de fora)
+	string json() const {
+		char buf[256];
+		snprintf(buf, sizeof(buf), "\"cplex_timelimit\":%g,\"cplex_threads\":%d,\"cplex_parallel\":\"%s\",\"cplex_lpmethod\":\"%s\",\"cplex_workmem\":%g,\"cplex_treemem\":%g,\"cplex_varsel\":%d",
+			tempo, threads, PARALELO[paralelo + 1], METODOS[metodo], memoria, arvore, varsel);
+		return buf;
+	}
+
+	void imprimir() const {
+		printf("Parametros do CPLEX: timelimit %g - threads %d - parallel %s - lpmethod %s - workmem %g - treemem %g - varsel %d\n",
+			tempo, threads, PARALELO[paralelo + 1], METODOS[metodo], memoria, arvore, varsel);
+	}
+
+#ifndef SEM_CPLEX
+	void aplicar(IloCplex& cplex) const {
+		cplex.setParam(IloCplex::TiLim, tempo);
+		cplex.setParam(IloCplex::Threads, threads);
+		cplex.setParam(IloCplex::ParallelMode, paralelo);
+		cplex.setParam(IloCplex::RootAlg, metodo);
+		if(memoria > 0) cplex.setParam(IloCplex::WorkMem, memoria);
+		if(arvore > 0) cplex.setParam(IloCplex::TreLim, arvore);
+		cplex.setParam(IloCplex::VarSel, varsel);
+	}
+
+	void aplicar(CPXENVptr amb) const {
+		CPXsetdblparam(amb, CPXPARAM_TimeLimit, tempo);
+		CPXsetintparam(amb, CPXPARAM_Threads, threads);
+		CPXsetintparam(amb, CPXPARAM_Parallel, paralelo);
+		CPXsetintparam(amb, CPXPARAM_LPMethod, metodo);
+		CPXsetintparam(amb, CPXPARAM_MIP_Strategy_StartAlgorithm, metodo);	//no callable a raiz do MIP tem parametro proprio
+		if(memoria > 0) CPXsetdblparam(amb, CPXPARAM_WorkMem, memoria);
+		if(arvore > 0) CPXsetdblparam(amb, CPXPARAM_MIP_Limits_TreeMemory, arvore);
+		CPXsetintparam(amb, CPXPARAM_MIP_Strategy_VariableSelect, varsel);
+	}
+#endif
+};
+
+#endif
@@ -0,0 +1,166 @@
+/*---------------- File: saida.h  -----------------------+
+|Saida das solucoes: texto, JSON lines ou binario        |
+|					      		                        |
+| Os motores entregam so as variaveis nao nulas; o       |
+| registro de cada instancia sai de uma vez no emitir(). |
+| --quiet deixa so status, FO e tempo no texto.          |
++-------------------------------------------------------+ */
+
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <bits/stdc++.h>
+
+using namespace std;
+
+//Registro binario (--output=binary): cabecalho, nome da instancia e as colunas i[], j[], x[]
+struct RegistroSolucao {
+	static constexpr char MAGICA[8] = {'P', 'O', 'S', 'O', 'L', 'U', 'C', '1'};
+
+	char magica[8];
+	char status[16];	//Optimal, Feasible ou No Solution
+	int64_t tamNome;	//bytes do nome da instancia, logo depois do cabecalho
+	int64_t nVar;	//variaveis nao nulas
+	double fo;
+	double tempo;	//segundos
+};
+
+struct Saida {
+	string formato = "text";	//--output=text|jsonl|binary
+	bool quieto = false;	//--quiet: sem eco da entrada, informacoes da execucao e lista de variaveis
+	string instancia;	//nome da instancia no registro
+	string estado;	//status do ultimo registro emitido (vazio: nenhum)
+	bool adiada = false;	//corrida de motores: emitir() so guarda o status, quem emite e o vencedor
+
+	//Solucao da instancia atual
+	vector<int> vi, vj;
+	vector<double> vx;
+	bool sol = false;
+	string foTexto;	//FO como o motor imprime (cout)
+	string foJson;	//FO com todos os digitos
+	double fo = 0, tempo = 0;
+	string anexoTexto;	//linhas extras do registro no texto (ex.: corte minimo), depois da FO
+	string anexoJson;	//campos extras do registro JSON, sem as chaves de fora
+
+	bool valido() const { return formato == "text" || formato == "jsonl" || formato == "binary"; }
+
+	bool texto() const { return formato == "text"; }
+	//Eco da entrada, informacoes da execucao e log do solver: so no texto sem --quiet
+	bool detalhes() const { return texto() && !quieto; }
+
+	void iniciar(const string& nome){
+		instancia = nome;
+		estado.clear();
+		vi.clear();
+		vj.clear();
+		vx.clear();
+		sol = false;
+		fo = tempo = 0;
+		anexoTexto.clear();
+		anexoJson.clear();
+	}
+
+	void variavel(int i, int j, double x){
+		vi.push_back(i);
+		vj.push_back(j);
+		vx.push_back(x);
+	}
+
+	template<class T>
+	void solucao(T valor, double segundos){
+		ostringstream s;
+		char buf[32];
+		s << valor;
+		foTexto = s.str();
+		if(is_integral<T>::value) foJson = to_string((long long)valor);
+		else{
+			snprintf(buf, sizeof(buf), "%.17g", (double)valor);
+			foJson = buf;
+		}
+		fo = valor;
+		tempo = segundos;
+		sol = true;
+	}
+
+	//Acrescenta ao registro linhas de texto e campos JSON extras
+	void anexar(const string& texto, const string& json){
+		anexoTexto += texto;
+		if(!json.empty()) anexoJson += (anexoJson.empty() ? "" : ",") + json;
+	}
+
+	//Solucao de outro motor da corrida (a configuracao da saida continua a desta)
+	void adotar(const Saida& s){
+		vi = s.vi;
+		vj = s.vj;
+		vx = s.vx;
+		sol = s.sol;
+		foTexto = s.foTexto;
+		foJson = s.foJson;
+		fo = s.fo;
+		tempo = s.tempo;
+		anexoTexto = s.anexoTexto;
+		anexoJson = s.anexoJson;
+	}
+
+	//Escreve o registro da instancia no formato escolhido
+	void emitir(const string& status){
+		estado = status;
+		if(adiada) return;
+		if(formato == "jsonl") emitirJson(status);
+		else if(formato == "binary") emitirBinario(status);
+		else emitirTexto(status);
+		fflush(stdout);
+	}
+
+	void emitirTexto(const string& status){
+		cout << endl << endl;
+		cout << "Status da FO: " << status << endl;
+		if(!sol){
+			printf("No Solution!\n");
+			return;
+		}
+		if(!quieto){
+			cout << "Variaveis de decisao: " << endl;
+			for( size_t k = 0; k < vx.size(); k++ ) printf("x[%d, %d]: %.0lf\n", vi[k], vj[k], vx[k]);
+			printf("\n");
+		}
+		cout << "Funcao Objetivo Valor = " << foTexto << endl;
+		printf("..(%.6lf seconds).\n\n", tempo);
+		if(!anexoTexto.empty()) printf("%s\n", anexoTexto.c_str());
+	}
+
+	void emitirJson(const string& status){
+		string nome;
+		for( char c : instancia ){
+			if(c == '"' || c == '\\') nome += '\\';
+			nome += c;
+		}
+		printf("{\"instancia\":\"%s\",\"status\":\"%s\"", nome.c_str(), status.c_str());
+		if(sol){
+			printf(",\"fo\":%s,\"tempo\":%.6lf,\"x\":[", foJson.c_str(), tempo);
+			for( size_t k = 0; k < vx.size(); k++ ) printf("%s[%d,%d,%.17g]", k ? "," : "", vi[k], vj[k], vx[k]);
+			printf("]");
+			if(!anexoJson.empty()) printf(",%s", anexoJson.c_str());
+		}
+		printf("}\n");
+	}
+
+	void emitirBinario(const string& status){
+		RegistroSolucao r;
+		memset(&r, 0, sizeof(r));
+		memcpy(r.magica, RegistroSolucao::MAGICA, 8);
+		strncpy(r.status, status.c_str(), 15);
+		r.tamNome = instancia.size();
+		r.nVar = sol ? vx.size() : 0;
+		r.fo = fo;
+		r.tempo = tempo;
+		fflush(stdout);
+		fwrite(&r, sizeof(r), 1, stdout);
+		fwrite(instancia.data(), 1, instancia.size(), stdout);
+		fwrite(vi.data(), sizeof(int), r.nVar, stdout);
+		fwrite(vj.data(), sizeof(int), r.nVar, stdout);
+		fwrite(vx.data(), sizeof(double), r.nVar, stdout);
+	}
+};
+
+#endif
@@ -0,0 +1,344 @@
+/*---------------- File: transporte.h  ------------------+
+|Problema do Transporte - Simplex de Transporte          |
+|					      		                        |
+| Base inicial pela aproximacao de Vogel, pivos MODI     |
+| (u_i + v_j = c_ij na base) com ciclo stepping-stone    |
+| na arvore da base e precificacao por blocos de linhas. |
++-------------------------------------------------------+ */
+
+#ifndef TRANSPORTE_H
+#define TRANSPORTE_H
+
+#include <bits/stdc++.h>
+#include "grafo.h"
+
+using namespace std;
+
+//Alocador alinhado a linha de cache, para as linhas da matriz de custos
+template<class T>
+struct Alinhado64 {
+	typedef T value_type;
+	Alinhado64(){}
+	template<class U> Alinhado64(const Alinhado64<U>&){}
+	T* allocate(size_t k){
+		void* p = aligned_alloc(64, (k * sizeof(T) + 63) / 64 * 64);
+		if(!p) throw bad_alloc();
+		return (T*)p;
+	}
+	void deallocate(T* p, size_t){ free(p); }
+	template<class U> bool operator==(const Alinhado64<U>&) const { return true; }
+	template<class U> bool operator!=(const Alinhado64<U>&) const { return false; }
+};
+
+struct Transporte {
+	enum Status { OTIMO, INVIAVEL };
+
+	static constexpr long long INF = numeric_limits<long long>::max() / 4;
+
+	int O = 0, D = 0;	//origens e demandas do problema
+	int n = 0, m = 0;	//linhas e colunas internas (coluna D ficticia se sobra oferta)
+	int passo = 0;	//colunas alocadas por linha (multiplo de 8: cada linha comeca alinhada)
+	vector<long long, Alinhado64<long long>> c;	//custo da linha i na coluna j em c[i*passo + j]
+	vector<long long> oferta, demanda;
+
+	//Base: n+m-1 celulas formando uma arvore sobre linhas (0..n-1) e colunas (n..n+m-1)
+	vector<int> celI, celJ;
+	vector<long long> celX;
+	vector<vector<int>> adj;	//celulas da base em cada vertice
+	vector<int> pai, prof;	//celula que liga ao pai e profundidade, raiz na linha 0
+	vector<long long> u;	//potenciais das linhas
+	vector<long long, Alinhado64<long long>> v;	//potenciais das colunas
+	int tamBloco = 1, proxLinha = 0;
+	long long nPivos = 0;
+
+	//O simplex de transporte assume custos nao negativos (sobra de oferta vai a coluna ficticia)
+	static bool custosValidos(const Grafo& g){
+		for( int k = 0; k < g.m; k++ ) if(g.custo[k] < 0) return false;
+		return true;
+	}
+
+	//Matriz densa a partir do grafo origem -> demanda (pares ausentes custam 0)
+	void carregar(const Grafo& g, const vector<long long>& a, const vector<long long>& b){
+		long long somaA = 0, somaB = 0;
+
+		O = g.n;
+		D = g.nDest;
+		oferta = a;
+		demanda = b;
+		for( int i = 0; i < O; i++ ) somaA += a[i];
+		for( int j = 0; j < D; j++ ) somaB += b[j];
+		if(somaA > somaB) demanda.push_back(somaA - somaB);
+
+		n = O;
+		m = demanda.size();
+		passo = (m + 7) / 8 * 8;
+		c.assign((size_t)n * passo, 0);
+		for( int k = 0; k < g.m; k++ ) c[(size_t)g.origem[k] * passo + g.destino[k]] = g.custo[k];
+	}
+
+	long long custo(int i, int j) const { return c[(size_t)i * passo + j]; }
+
+	//Vertice do outro lado da celula e a partir de x
+	int outro(int e, int x) const { return x < n ? n + celJ[e] : celI[e]; }
+
+	long long& potencial(int x){ return x < n ? u[x] : v[x - n]; }
+
+	int addBase(int i, int j, long long x){
+		celI.push_back(i);
+		celJ.push_back(j);
+		celX.push_back(x);
+		adj[i].push_back(celI.size() - 1);
+		adj[n + j].push_back(celI.size() - 1);
+		return celI.size() - 1;
+	}
+
+	//Ordena os k menores de o[ini..len) nas posicoes ini.. e devolve o fim do trecho ordenado
+	template<class F>
+	static int ordenarTrecho(int* o, int ini, int len, int k, F custoDe, vector<pair<long long, int>>& tmp){
+		int p, fim = min(len, ini + k);
+		for( p = ini; p < len; p++ ) tmp[p - ini] = make_pair(custoDe(o[p]), o[p]);
+		if(fim < len) nth_element(tmp.begin(), tmp.begin() + (fim - ini), tmp.begin() + (len - ini));
+		sort(tmp.begin(), tmp.begin() + (fim - ini));
+		for( p = ini; p < len; p++ ) o[p] = tmp[p - ini].second;
+		return fim;
+	}
+
+	//Avanca p ate o proximo indice ativo de o, ordenando o resto em trechos crescentes
+	//conforme e preciso (a maioria das linhas nunca passa dos primeiros)
+	template<class F>
+	static void proximoAtivo(int* o, int& p, int len, int& fim, const vector<char>& ativo, F custoDe, vector<pair<long long, int>>& tmp){
+		while(p < len){
+			if(p >= fim) fim = ordenarTrecho(o, fim, len, max(32, fim), custoDe, tmp);
+			if(ativo[o[p]]) return;
+			p++;
+		}
+	}
+
+	//Aproximacao de Vogel: cada linha/coluna guarda seus indices ordenados por custo e
+	//dois ponteiros monotonos para o primeiro e o segundo ainda ativos; a penalidade so e
+	//recalculada quando um desses dois sai
+	void vogel(){
+		int i, j, nL = n, nC = m;
+		vector<int> ordL((size_t)n * m), ordC((size_t)m * n);
+		vector<int> pL1(n, 0), pL2(n, 1), pC1(m, 0), pC2(m, 1), fimL(n, 0), fimC(m, 0);
+		vector<int> prL(n, -1), seL(n, -1), prC(m, -1), seC(m, -1);	//primeiro e segundo ativos, refeitos so quando um deles sai
+		vector<long long> c1L(n), penL(n), c1C(m), penC(m);
+		vector<char> ativoL(n, 1), ativoC(m, 1);
+		vector<long long> restoA(oferta), restoB(demanda);
+
+		vector<pair<long long, int>> tmp(max(n, m));
+		for( i = 0; i < n; i++ ) iota(&ordL[(size_t)i * m], &ordL[(size_t)i * m] + m, 0);
+		for( j = 0; j < m; j++ ) iota(&ordC[(size_t)j * n], &ordC[(size_t)j * n] + n, 0);
+
+		while(nL > 0 && nC > 0){
+			long long melhorPen = -1, melhorCusto = INF;
+			int linha = -1, coluna = -1;
+
+			for( i = 0; i < n; i++ ){
+				if(!ativoL[i]) continue;
+				if(prL[i] < 0 || !ativoC[prL[i]] || (seL[i] >= 0 && !ativoC[seL[i]])){
+					int* o = &ordL[(size_t)i * m];
+					auto custoDe = [&](int col){ return custo(i, col); };
+					proximoAtivo(o, pL1[i], m, fimL[i], ativoC, custoDe, tmp);
+					pL2[i] = max(pL2[i], pL1[i] + 1);
+					proximoAtivo(o, pL2[i], m, fimL[i], ativoC, custoDe, tmp);
+					prL[i] = o[pL1[i]];
+					seL[i] = pL2[i] < m ? o[pL2[i]] : -1;
+					c1L[i] = custo(i, prL[i]);
+					penL[i] = seL[i] >= 0 ? custo(i, seL[i]) - c1L[i] : c1L[i];
+				}
+				if(penL[i] > melhorPen || (penL[i] == melhorPen && c1L[i] < melhorCusto)){
+					melhorPen = penL[i];
+					melhorCusto = c1L[i];
+					linha = i;
+					coluna = prL[i];
+				}
+			}
+			for( j = 0; j < m; j++ ){
+				if(!ativoC[j]) continue;
+				if(prC[j] < 0 || !ativoL[prC[j]] || (seC[j] >= 0 && !ativoL[seC[j]])){
+					int* o = &ordC[(size_t)j * n];
+					auto custoDe = [&](int lin){ return custo(lin, j); };
+					proximoAtivo(o, pC1[j], n, fimC[j], ativoL, custoDe, tmp);
+					pC2[j] = max(pC2[j], pC1[j] + 1);
+					proximoAtivo(o, pC2[j], n, fimC[j], ativoL, custoDe, tmp);
+					prC[j] = o[pC1[j]];
+					seC[j] = pC2[j] < n ? o[pC2[j]] : -1;
+					c1C[j] = custo(prC[j], j);
+					penC[j] = seC[j] >= 0 ? custo(seC[j], j) - c1C[j] : c1C[j];
+				}
+				if(penC[j] > melhorPen || (penC[j] == melhorPen && c1C[j] < melhorCusto)){
+					melhorPen = penC[j];
+					melhorCusto = c1C[j];
+					linha = prC[j];
+					coluna = j;
+				}
+			}
+
+			long long q = min(restoA[linha], restoB[coluna]);
+			addBase(linha, coluna, q);
+			restoA[linha] -= q;
+			restoB[coluna] -= q;
+			//Uma linha ou coluna sai por alocacao: a base fica com n+m-1 celulas
+			if(restoA[linha] == 0 && (restoB[coluna] != 0 || nL > 1)){
+				ativoL[linha] = 0;
+				nL--;
+			}else{
+				ativoC[coluna] = 0;
+				nC--;
+			}
+		}
+	}
+
+	//Pai, profundidade e potenciais da subarvore de s, pendurada pela celula e
+	void enraizar(int s, int e, int profS){
+		vector<int> pilha(1, s);
+		pai[s] = e;
+		prof[s] = profS;
+		while(!pilha.empty()){
+			int x = pilha.back();
+			pilha.pop_back();
+			if(pai[x] >= 0){
+				int p = outro(pai[x], x);
+				potencial(x) = custo(celI[pai[x]], celJ[pai[x]]) - potencial(p);
+			}
+			for( int f : adj[x] ){
+				if(f == pai[x]) continue;
+				int y = outro(f, x);
+				pai[y] = f;
+				prof[y] = prof[x] + 1;
+				pilha.push_back(y);
+			}
+		}
+	}
+
+	//Menor custo reduzido c_ij - u_i - v_j em blocos de linhas; o minimo de cada linha e
+	//um laco sem desvios sobre c e v contiguos, que o compilador vetoriza
+	bool precificar(int& ei, int& ej){
+		long long melhor = 0;
+		int linha = -1, cont = tamBloco, r, i, j;
+		const long long* vj = v.data();
+
+		for( r = 0; r < n; r++ ){
+			i = proxLinha + r < n ? proxLinha + r : proxLinha + r - n;
+			const long long* ci = &c[(size_t)i * passo];
+			long long menor = INF;
+			for( j = 0; j < m; j++ ) menor = min(menor, ci[j] - vj[j]);
+			if(menor - u[i] < melhor){
+				melhor = menor - u[i];
+				linha = i;
+			}
+			if(--cont == 0){
+				if(melhor < 0) break;
+				cont = tamBloco;
+			}
+		}
+		if(linha < 0) return false;
+
+		proxLinha = r < n ? (proxLinha + r + 1) % n : proxLinha;
+		const long long* ci = &c[(size_t)linha * passo];
+		for( j = 0; j < m && ci[j] - vj[j] - u[linha] != melhor; j++ );
+		ei = linha;
+		ej = j;
+		return true;
+	}
+
+	//Ciclo stepping-stone da celula (i, j): caminho na arvore entre a linha i e a coluna j,
+	//com sinais alternados a partir de cada ponta (primeira celula de cada lado perde)
+	void pivotar(int i, int j){
+		vector<int> ladoA, ladoB;
+		int a = i, b = n + j, sai = -1, s, t;
+		long long theta = INF;
+		bool saiA = false;
+
+		while(a != b){
+			if(prof[a] >= prof[b]){
+				ladoA.push_back(pai[a]);
+				a = outro(pai[a], a);
+			}else{
+				ladoB.push_back(pai[b]);
+				b = outro(pai[b], b);
+			}
+		}
+		for( size_t p = 0; p < ladoB.size(); p += 2 ){
+			if(celX[ladoB[p]] < theta){
+				theta = celX[ladoB[p]];
+				sai = ladoB[p];
+				saiA = false;
+			}
+		}
+		for( size_t p = 0; p < ladoA.size(); p += 2 ){
+			if(celX[ladoA[p]] < theta){
+				theta = celX[ladoA[p]];
+				sai = ladoA[p];
+				saiA = true;
+			}
+		}
+
+		for( size_t p = 0; p < ladoA.size(); p++ ) celX[ladoA[p]] += p % 2 ? theta : -theta;
+		for( size_t p = 0; p < ladoB.size(); p++ ) celX[ladoB[p]] += p % 2 ? theta : -theta;
+
+		//A celula que sai da lugar a que entra (mesmo indice)
+		for( int x : { celI[sai], n + celJ[sai] } ){
+			vector<int>& l = adj[x];
+			*find(l.begin(), l.end(), sai) = l.back();
+			l.pop_back();
+		}
+		celI[sai] = i;
+		celJ[sai] = j;
+		celX[sai] = theta;
+		adj[i].push_back(sai);
+		adj[n + j].push_back(sai);
+
+		//O lado da arvore que perdeu a ligacao com a raiz e pendurado pela nova celula
+		s = saiA ? i : n + j;
+		t = saiA ? n + j : i;
+		enraizar(s, sai, prof[t] + 1);
+		nPivos++;
+	}
+
+	Status resolver(){
+		long long somaA = 0, somaB = 0;
+		int ei, ej;
+
+		for( int i = 0; i < n; i++ ) somaA += oferta[i];
+		for( int j = 0; j < m; j++ ) somaB += demanda[j];
+		if(somaA != somaB) return INVIAVEL;
+		if(n == 0 || m == 0) return OTIMO;
+
+		celI.clear();
+		celJ.clear();
+		celX.clear();
+		adj.assign(n + m, vector<int>());
+		pai.assign(n + m, -1);
+		prof.assign(n + m, 0);
+		u.assign(n, 0);
+		v.assign(passo, 0);
+		nPivos = 0;
+
+		vogel();
+		enraizar(0, -1, 0);
+		u[0] = 0;
+
+		tamBloco = max(1, (int)(sqrt((double)n * m) / m));
+		proxLinha = 0;
+		while(precificar(ei, ej)) pivotar(ei, ej);
+		return OTIMO;
+	}
+
+	//Celulas com envio positivo nas demandas reais, na ordem (i, j)
+	vector<int> envios() const {
+		vector<int> r;
+		for( size_t e = 0; e < celI.size(); e++ ) if(celX[e] > 0 && celJ[e] < D) r.push_back(e);
+		sort(r.begin(), r.end(), [&](int x, int y){ return make_pair(celI[x], celJ[x]) < make_pair(celI[y], celJ[y]); });
+		return r;
+	}
+
+	long long custoTotal() const {
+		long long total = 0;
+		for( size_t e = 0; e < celI.size(); e++ ) total += custo(celI[e], celJ[e]) * celX[e];
+		return total;
+	}
+};
+
+#endif
@@ -0,0 +1,123 @@
+/*---------------- File: main.cpp  ---------------------+
+|Conversor in.txt -> formato binario (comum/binario.h)   |
+|					      		                        |
+| Uso: conversor.exe --problem=pfmax in.txt in.bin       |
+| (sem o arquivo de entrada le de stdin). Os solvers     |
+| aceitam o .bin no lugar do in.txt. --sparse (pd) grava |
+| so os pares lidos, para o pd --sparse.                 |
++-------------------------------------------------------+ */
+
+#include <bits/stdc++.h>
+#include "../comum/grafo.h"
+#include "../comum/binario.h"
+#include "../comum/leitor.h"
+
+using namespace std;
+
+//Formato de cada problema no in.txt (o mesmo que o ler() de cada main)
+struct Formato {
+	string nome;
+	int campos;	//inteiros por linha de arco
+	bool completo;	//todos os pares (origem, destino) existem, com custo 0 se nao lidos
+};
+
+const Formato formatos[] = {
+	{"pcm", 3, false},
+	{"pd", 3, true},
+	{"pfcm", 4, false},
+	{"pfmax", 3, false},
+	{"pt", 3, true},
+};
+
+int main(int argc, char* argv[]) {
+
+	string problema, entrada, saida;
+	int a, i, j, v, O, D, F = 0;
+	vector<int> prefixo;
+	long long nRotas = 0;
+	bool esparso = false;
+
+	for(a=1; a<argc; a++) {
+		if(strncmp(argv[a], "--problem=", 10) == 0) problema = argv[a] + 10;
+		else if(strcmp(argv[a], "--sparse") == 0) esparso = true;
+		else if(saida.empty()) saida = argv[a];
+		else {
+			entrada = saida;
+			saida = argv[a];
+		}
+	}
+	const Formato* fmt = nullptr;
+	for( const Formato& f : formatos ) if(f.nome == problema) fmt = &f;
+	if(fmt == nullptr || saida.empty() || (esparso && problema != "pd")) {
+		fprintf(stderr, "Uso: %s --problem=pcm|pd|pfcm|pfmax|pt [--sparse] [in.txt] saida.bin\n", argv[0]);
+		return 1;
+	}
+
+	ifstream arquivo;
+	if(!entrada.empty()) {
+		arquivo.open(entrada, ios::binary);
+		if(!arquivo) {
+			fprintf(stderr, "Nao foi possivel abrir %s\n", entrada.c_str());
+			return 1;
+		}
+	}
+	Leitor in(entrada.empty() ? cin : arquivo, entrada.empty() ? "stdin" : entrada);
+
+	//Cabecalho: quantidades e, conforme o problema, ofertas, demandas e vertices de passagem
+	int nQtd = fmt->completo ? 2 : 3;
+	if(in.vazio()) {
+		fprintf(stderr, "Instancia vazia\n");
+		return 1;
+	}
+	for(i=0; i<nQtd; i++) {
+		if(!in.campo(v, "o cabecalho")) return 1;
+		prefixo.push_back(v);
+	}
+	O = prefixo[0];
+	D = prefixo[1];
+	if(nQtd == 3) F = prefixo[2];
+	bool comQtd = problema == "pd" || problema == "pt" || problema == "pfcm";
+	if(O < 0 || (comQtd && (D < 0 || F < 0))) {
+		in.falha(in.linha, "quantidade negativa no cabecalho");
+		return 1;
+	}
+	int nVertices = problema == "pfcm" ? O + D + F : O;
+	int nChegada = fmt->completo ? D : nVertices;
+	if(!comQtd && (!in.intervalo(D, O, "origem") || !in.intervalo(F, O, "destino"))) return 1;
+	int nResto = problema == "pt" ? O + D : problema == "pfcm" ? 2*O + 2*D + F : 0;
+	for(i=0; i<nResto; i++) {
+		if(!in.campo(v, "o cabecalho")) return 1;
+		//Na pfcm os ids de origens, demandas e locais de passagem tambem sao vertices
+		if(problema == "pfcm" && (i < 2*O + 2*D ? i % 2 == 0 : true) && !in.intervalo(v, nVertices, "vertice")) return 1;
+		prefixo.push_back(v);
+	}
+
+	//Arcos, com as mesmas regras do ler() de cada main
+	ListaArcos lista;
+	if(fmt->completo && !esparso) {
+		for(i=0; i<O; i++) {
+			for(j=0; j<D; j++) lista.add(i, j, 0, 0);
+		}
+	}
+	int campo[4];
+	while(in.registro(campo, fmt->campos)) {
+		if(!in.intervalo(campo[0], nVertices, "origem") || !in.intervalo(campo[1], nChegada, "destino")) return 1;
+		if(problema == "pfmax") lista.add(campo[0], campo[1], 0, campo[2]);
+		else if(problema == "pfcm") lista.add(campo[0], campo[1], campo[2], campo[3]);
+		else lista.add(campo[0], campo[1], campo[2], 0);
+		nRotas++;
+	}
+	if(in.erro) return 1;
+
+	Grafo g;
+	g.montar(nVertices, nChegada, lista);
+	if(problema == "pfmax") g.removerSemCapacidade();
+
+	if(!gravarBinario(saida, problema, prefixo, nRotas, g)) {
+		fprintf(stderr, "Nao foi possivel gravar %s\n", saida.c_str());
+		return 1;
+	}
+	printf("%s: %d vertices, %d arcos (%lld linhas de arco) -> %s\n", problema.c_str(), g.n, g.m, nRotas, saida.c_str());
+
+    return 0;
+}
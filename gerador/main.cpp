@@ -0,0 +1,233 @@
+/*---------------- File: main.cpp  ---------------------+
+|Gerador de instancias sinteticas (formato in.txt)       |
+|					      		                        |
+| Uso: gerador.exe --problem=pd --size=1000 [--kind=...] |
+|      [--seed=1] [--degree=4] [--maxcost=100]           |
+|      [--maxcap=1000] [--rows=O --cols=D] [--sparse]    |
+|      > in.txt                                          |
++-------------------------------------------------------+ */
+
+#include <bits/stdc++.h>
+
+using namespace std;
+
+/*
+* Tipos (--kind):
+* random: pd/pt com custos uniformes; pcm/pfmax/pfcm com um ciclo por todos os
+*         vertices (garante conexao) e mais degree-1 arcos por vertice para
+*         vertices sorteados
+* grid:   pd/pt com pontos sorteados numa grade 1000x1000 e custo igual a
+*         distancia de Manhattan; pcm/pfmax/pfcm numa grade de ruas com arcos
+*         nos dois sentidos entre vizinhos e alguns atalhos (rodovias)
+*
+* --sparse (pd): cada pessoa lista so degree tarefas; uma designacao sorteada esta
+*         sempre entre os pares, entao a instancia tem solucao
+*
+* Default: random
+*/
+
+//Saida em blocos (printf por linha domina o tempo em instancias grandes)
+struct Escritor {
+	vector<char> buf = vector<char>(1 << 20);
+	size_t pos = 0;
+
+	~Escritor(){ descarregar(); }
+	void descarregar(){
+		fwrite(buf.data(), 1, pos, stdout);
+		pos = 0;
+	}
+	void inteiro(long long v){
+		if(pos + 24 > buf.size()) descarregar();
+		pos = to_chars(buf.data() + pos, buf.data() + buf.size(), v).ptr - buf.data();
+	}
+	void caractere(char c){
+		if(pos + 1 > buf.size()) descarregar();
+		buf[pos++] = c;
+	}
+	void linha(initializer_list<long long> campos){
+		bool primeiro = true;
+		for( long long v : campos ){
+			if(!primeiro) caractere(' ');
+			inteiro(v);
+			primeiro = false;
+		}
+		caractere('\n');
+	}
+};
+
+mt19937_64 rng; //Gerador pseudoaleatorio (--seed)
+Escritor out;
+
+long long sortear(long long a, long long b){
+	return uniform_int_distribution<long long>(a, b)(rng);
+}
+
+//Arcos (o, d) de uma rede "rodoviaria" com n vertices
+vector<pair<int, int>> rede(int n, const string& tipo, int grau){
+	vector<pair<int, int>> arcos;
+	int i, k;
+
+	if(tipo == "grid"){
+		int lado = max(1, (int)ceil(sqrt((double)n)));
+		for( i = 0; i < n; i++ ){
+			int l = i / lado, c = i % lado;
+			if(c + 1 < lado && i + 1 < n){
+				arcos.push_back({i, i + 1});
+				arcos.push_back({i + 1, i});
+			}
+			if(l + 1 < lado && i + lado < n){
+				arcos.push_back({i, i + lado});
+				arcos.push_back({i + lado, i});
+			}
+		}
+		//Atalhos: cerca de 1% dos vertices ganha uma ligacao longa
+		for( k = 0; k < n / 100; k++ ){
+			int a = sortear(0, n - 1), b = sortear(0, n - 1);
+			if(a != b) arcos.push_back({a, b});
+		}
+	}else{
+		for( i = 0; i < n && n > 1; i++ ){
+			arcos.push_back({i, (i + 1) % n});
+			for( k = 1; k < grau; k++ ){
+				int b = sortear(0, n - 1);
+				if(b != i) arcos.push_back({i, b});
+			}
+		}
+	}
+	return arcos;
+}
+
+//Custos entre O pontos de saida e D de chegada: uniformes ou distancia de Manhattan na grade
+vector<int> matrizCustos(int O, int D, const string& tipo, int maxCusto){
+	vector<int> c((size_t)O * D);
+	if(tipo == "grid"){
+		vector<int> xo(O), yo(O), xd(D), yd(D);
+		for( int i = 0; i < O; i++ ){ xo[i] = sortear(0, 999); yo[i] = sortear(0, 999); }
+		for( int j = 0; j < D; j++ ){ xd[j] = sortear(0, 999); yd[j] = sortear(0, 999); }
+		for( int i = 0; i < O; i++ ) for( int j = 0; j < D; j++ ) c[(size_t)i * D + j] = abs(xo[i] - xd[j]) + abs(yo[i] - yd[j]);
+	}else{
+		for( auto& v : c ) v = sortear(1, maxCusto);
+	}
+	return c;
+}
+
+//Pares (pessoa, tarefa) do pd esparso: degree tarefas por pessoa, incluindo as de uma
+//designacao sorteada do lado menor. Custos uniformes ou distancia de Manhattan na grade.
+void designacaoEsparsa(int O, int D, const string& tipo, int grau, int maxCusto){
+	vector<int> dono(O, -1), xo(O), yo(O), xd(D), yd(D), lista;
+	int i, j;
+
+	if(tipo == "grid"){
+		for( i = 0; i < O; i++ ){ xo[i] = sortear(0, 999); yo[i] = sortear(0, 999); }
+		for( j = 0; j < D; j++ ){ xd[j] = sortear(0, 999); yd[j] = sortear(0, 999); }
+	}
+	vector<int> p(max(O, D));
+	iota(p.begin(), p.end(), 0);
+	shuffle(p.begin(), p.end(), rng);
+	for( i = 0; i < min(O, D); i++ ){
+		if(O <= D) dono[i] = p[i];
+		else dono[p[i]] = i;
+	}
+
+	out.linha({O, D});
+	for( i = 0; i < O; i++ ){
+		lista.clear();
+		if(dono[i] >= 0) lista.push_back(dono[i]);
+		while((int)lista.size() < min(grau, D)){
+			j = sortear(0, D - 1);
+			if(find(lista.begin(), lista.end(), j) == lista.end()) lista.push_back(j);
+		}
+		for( int t : lista ) out.linha({i, t, tipo == "grid" ? abs(xo[i] - xd[t]) + abs(yo[i] - yd[t]) : sortear(1, maxCusto)});
+	}
+}
+
+//Quantidades sorteadas em [10, 100] que somam exatamente total (total >= 10*k)
+vector<long long> repartir(int k, long long total){
+	vector<long long> q(k);
+	long long soma = 0;
+	for( auto& v : q ){ v = sortear(10, 100); soma += v; }
+	for( int i = 0; i < k; i++ ) q[i] = q[i] * total / soma;
+	soma = accumulate(q.begin(), q.end(), 0LL);
+	for( int i = 0; soma < total; i = (i + 1) % k, soma++ ) q[i]++;
+	return q;
+}
+
+int main(int argc, char* argv[]) {
+
+	string problema, tipo = "random";
+	long long seed = 1;
+	int n = 0, O = 0, D = 0, grau = 4, maxCusto = 100, maxCap = 1000;
+	int i, j;
+	bool esparso = false;
+
+	for(int a=1; a<argc; a++) {
+		if(strncmp(argv[a], "--problem=", 10) == 0) problema = argv[a] + 10;
+		if(strncmp(argv[a], "--kind=", 7) == 0) tipo = argv[a] + 7;
+		if(strncmp(argv[a], "--size=", 7) == 0) n = atoi(argv[a] + 7);
+		if(strncmp(argv[a], "--rows=", 7) == 0) O = atoi(argv[a] + 7);
+		if(strncmp(argv[a], "--cols=", 7) == 0) D = atoi(argv[a] + 7);
+		if(strncmp(argv[a], "--seed=", 7) == 0) seed = atoll(argv[a] + 7);
+		if(strncmp(argv[a], "--degree=", 9) == 0) grau = atoi(argv[a] + 9);
+		if(strncmp(argv[a], "--maxcost=", 10) == 0) maxCusto = atoi(argv[a] + 10);
+		if(strncmp(argv[a], "--maxcap=", 9) == 0) maxCap = atoi(argv[a] + 9);
+		if(strcmp(argv[a], "--sparse") == 0) esparso = true;
+	}
+	if(O == 0) O = n;
+	if(D == 0) D = n;
+	bool conhecido = problema == "pcm" || problema == "pd" || problema == "pfcm" || problema == "pfmax" || problema == "pt";
+	if(!conhecido || (tipo != "random" && tipo != "grid") || O <= 0 || D <= 0 || grau < 1 || maxCusto < 1 || maxCap < 1) {
+		fprintf(stderr, "Uso: %s --problem=pcm|pd|pfcm|pfmax|pt --size=N [--kind=random|grid] [--seed=S] [--degree=K] [--maxcost=C] [--maxcap=U] [--rows=O --cols=D] [--sparse]\n", argv[0]);
+		return 1;
+	}
+	rng.seed(seed);
+
+	if(problema == "pd" && esparso) {
+		designacaoEsparsa(O, D, tipo, grau, maxCusto);
+		return 0;
+	}
+	if(problema == "pd" || problema == "pt") {
+		vector<int> c = matrizCustos(O, D, tipo, maxCusto);
+		out.linha({O, D});
+		if(problema == "pt") {
+			//Oferta total igual a demanda total
+			long long total = 55LL * max(O, D);
+			for( long long v : repartir(O, total) ) out.linha({v});
+			for( long long v : repartir(D, total) ) out.linha({v});
+		}
+		for( i = 0; i < O; i++ ) for( j = 0; j < D; j++ ) out.linha({i, j, c[(size_t)i * D + j]});
+		return 0;
+	}
+
+	vector<pair<int, int>> arcos = rede(n, tipo, grau);
+
+	if(problema == "pcm") {
+		//Caminho do vertice 0 ao ultimo
+		out.linha({n, 0, n - 1});
+		for( auto& a : arcos ) out.linha({a.first, a.second, sortear(1, maxCusto)});
+	}
+	else if(problema == "pfmax") {
+		//Fluxo do vertice 0 ao ultimo
+		out.linha({n, 0, n - 1});
+		for( auto& a : arcos ) out.linha({a.first, a.second, sortear(1, maxCap)});
+	}
+	else {
+		//Cerca de 5% dos vertices sao origens e 5% demandas (ao menos um de cada); o resto e passagem.
+		//A oferta total e 20% maior que a demanda e as demandas sao pequenas frente as capacidades.
+		vector<int> ids(n);
+		iota(ids.begin(), ids.end(), 0);
+		shuffle(ids.begin(), ids.end(), rng);
+		int nO = max(1, n / 20), nD = max(1, n / 20);
+		if(nO + nD > n) nO = nD = n / 2;
+		int nF = n - nO - nD;
+		long long demanda = max(10LL * nD, (long long)nD * maxCap / 20);
+		vector<long long> oferta = repartir(nO, demanda + demanda / 5), procura = repartir(nD, demanda);
+
+		out.linha({nO, nD, nF});
+		for( i = 0; i < nO; i++ ) out.linha({ids[i], oferta[i]});
+		for( i = 0; i < nD; i++ ) out.linha({ids[nO + i], procura[i]});
+		for( i = 0; i < nF; i++ ) out.linha({ids[nO + nD + i]});
+		for( auto& a : arcos ) out.linha({a.first, a.second, sortear(1, maxCusto), sortear(maxCap / 2, maxCap)});
+	}
+
+    return 0;
+}
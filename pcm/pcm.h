@@ -0,0 +1,584 @@
+/*---------------- File: pcm.h  ------------------------+
+|Modelo PLI - Problema do Caminho MÍnimo (PCM)          |
+|					      		                        |
+|					      		                        |
+| Implementado por: LUIS ARTHUR DE ASSIS MORAES  	    |
+| 					ALEX DE ANDRADE SOARES  	        |
++-------------------------------------------------------+ */
+
+#ifndef PCM_H
+#define PCM_H
+
+#include <bits/stdc++.h>
+#include "../comum/execucao.h"
+#include "../comum/caminho_minimo.h"
+#include "../comum/paralelo.h"
+
+using namespace std;
+
+namespace pcm {
+
+//Conjuntos do Problema
+int O; //Quantidade de vertices
+Grafo g; //Conjunto de trajetos (custo em g.custo)
+int n_rotas = 0; //Quantidade de rotas lidas (repeticoes incluidas)
+int D; //Local de origem
+int F;	//Local de destino
+string heap = "binary"; //Heap do Dijkstra nativo: binary ou radix
+bool bidirecional = false; //Busca bidirecional no Dijkstra nativo
+string arquivoConsultas; //Modo de consultas (--queries=arquivo); vazio: um caminho por instancia
+string formatoConsulta = "matrix"; //Saida das consultas: matrix ou paths
+int nThreads = 0; //Threads do modo de consultas (--threads=, 0: uma por nucleo)
+
+#ifndef SEM_CPLEX
+//Modelo do CPLEX mantido entre as instancias do modo lote
+IloModel model;
+IloNumVarArray x; //Variaveis de decisao, uma por arco
+IloObjective fo;
+IloCplex solverCplex;
+vector<int> formaModelo; //Forma do modelo montado (vazia: nenhum)
+int numberVar = 0; //Total de Variaveis
+int numberRes = 0; //Total de Restricoes
+
+//O que define a estrutura do modelo: instancias com a mesma forma reaproveitam o modelo
+vector<int> forma(){
+	vector<int> f = {O, D, F};
+	f.insert(f.end(), g.origem.begin(), g.origem.end());
+	f.insert(f.end(), g.destino.begin(), g.destino.end());
+	return f;
+}
+
+void liberarModelo(){
+	if(formaModelo.empty()) return;
+	solverCplex.end();
+	model.end();
+	fo.end();
+	x.endElements();
+	x.end();
+	formaModelo.clear();
+}
+
+//Monta o modelo da instancia atual do zero
+void montarModelo(){
+	int i, k; //Auxiliares
+	numberVar = 0;
+	numberRes = 0;
+
+
+	//---------- MODELAGEM ---------------
+	//Definicao - Variaveis de Decisao (x_ij) binárias, uma por arco lido
+	x = IloNumVarArray(env);
+	for( k = 0; k < g.m; k++ ){
+		x.add(IloNumVar(env, 0, 1, relaxacaoLP ? ILOFLOAT : ILOINT));
+		numberVar++;
+	}
+
+	//Definicao do ambiente modelo ------------------------------------------
+	model = IloModel(env);
+	
+	//Definicao do ambiente expressoes, para os somatorios ---------------------------------
+	IloExpr sum(env); /// Expression for Sum
+	IloExpr sum2(env); /// Expression for Sum2
+
+	//FUNCAO OBJETIVO ---------------------------------------------
+	sum.clear();
+	for( k = 0; k < g.m; k++ ){
+		sum += (g.custo[k] * x[k]);
+	}
+
+	fo = IloMinimize(env, sum);
+	model.add(fo); //Minimizacao
+
+	//RESTRICOES ---------------------------------------------	
+	 
+	//Restrição da origem
+	i = D;
+	sum.clear();
+	for( k = g.inicio[i]; k < g.inicio[i+1]; k++ ){
+		sum += x[k];
+	}
+	model.add(sum == 1); 
+	numberRes++;
+
+	//Restrição do destino
+	i = F;
+	sum.clear();
+	for( k = g.inicioInv[i]; k < g.inicioInv[i+1]; k++ ){
+		sum += x[g.arcoInv[k]];
+	}
+	model.add(sum == 1); 
+	numberRes++;
+
+	//Restrição dos caminhos
+	for( i = 0; i < O; i++ ){
+		if ((i != D) && (i != F)) {
+			sum.clear();
+			for( k = g.inicio[i]; k < g.inicio[i+1]; k++ ){
+				sum += x[k];
+			}
+			for( k = g.inicioInv[i]; k < g.inicioInv[i+1]; k++ ){
+				sum -= x[g.arcoInv[k]];
+			}
+			model.add(sum == 0); 
+			numberRes++;
+		}
+	}
+
+	medicao.parar(Medicao::MODELO);
+	solverCplex = IloCplex(model); //extracao do modelo para o CPLEX
+	medicao.parar(Medicao::EXTRACAO);
+	formaModelo = forma();
+
+	sum.end();
+	sum2.end();
+}
+
+//Mesma forma do modelo montado: troca so coeficientes e lados direitos
+void atualizarModelo(){
+	int k; //Auxiliar
+	IloNumArray custos(env, g.m);
+
+	for( k = 0; k < g.m; k++ ) custos[k] = g.custo[k];
+	fo.setLinearCoefs(x, custos);
+	custos.end();
+}
+
+void cplex(){
+	//------ EXECUCAO do MODELO ----------
+	IloNum value, objValue;
+	double runTime;
+	string status;
+	bool sol;
+	int k; //Auxiliar
+
+	medicao.comecar();
+	//Instancia com a mesma forma da anterior: so troca coeficientes e lados direitos
+	if(formaModelo == forma()) atualizarModelo();
+	else{
+		liberarModelo();
+		montarModelo();
+	}
+	medicao.parar(Medicao::MODELO);
+	IloCplex cplex = solverCplex;
+	
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("#Var: %d\n", numberVar);
+		printf("#Restricoes: %d\n", numberRes);
+		memoriaCplex("after variable creation");
+	
+		memoriaCplex("after cplex(Model)");
+	}
+
+	status = resolverCplex(cplex, sol);
+
+	if(sol){ 
+
+		//Results
+		//int Nbin, Nint, Ncols, Nrows, Nnodes, Nnodes64;
+		objValue = cplex.getObjValue();
+		runTime = medicao.segundos(Medicao::RESOLUCAO);
+		IloNumArray valores(env);
+		cplex.getValues(valores, x); //todos os valores numa chamada so
+		//Informacoes Adicionais
+		//Nbin = cplex.getNbinVars();
+		//Nint = cplex.getNintVars();
+		//Ncols = cplex.getNcols();
+		//Nrows = cplex.getNrows();
+		//Nnodes = cplex.getNnodes();
+		//Nnodes64 = cplex.getNnodes64();
+		//float gap; gap = cplex.getMIPRelativeGap();
+		
+		for( k = 0; k < g.m; k++ ){
+			value = IloRound(valores[k]);
+			if(value != 0) saida.variavel(g.origem[k], g.destino[k], value);
+		}
+		valores.end();
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(status);
+
+	if(saida.detalhes()) memoriaCplex("before end");
+}
+#endif
+
+//Resolve com Dijkstra nativo (--heap=binary|radix, --bidirectional), imprimindo no mesmo formato do cplex()
+void nativo(){
+	int k; //Auxiliar
+	long long objValue;
+	double runTime;
+	CaminhoMinimo cm;
+
+	if(!CaminhoMinimo::custosValidos(g)){
+		fprintf(stderr, "Dijkstra exige custos nao negativos: use --engine=cplex\n");
+		saida.emitir("No Solution");
+		return;
+	}
+
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("Motor: Dijkstra %s, heap %s (nativo)\n", bidirecional ? "bidirecional" : "unidirecional", heap.c_str());
+		printf("#Arcos: %d\n", g.m);
+	}
+
+	medicao.comecar();
+	if(heap == "radix") objValue = bidirecional ? cm.bidirecional<HeapRadix>(g, D, F) : cm.dijkstra<HeapRadix>(g, D, F);
+	else objValue = bidirecional ? cm.bidirecional<HeapBinario>(g, D, F) : cm.dijkstra<HeapBinario>(g, D, F);
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+
+	bool sol = objValue < CaminhoMinimo::INF;
+	if(sol){
+		vector<int> arcos = cm.caminho();
+		for( k = 0; k < (int)arcos.size(); k++ ){
+			saida.variavel(g.origem[arcos[k]], g.destino[arcos[k]], 1);
+		}
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(sol ? "Optimal" : "No Solution");
+}
+
+
+//Le uma instancia (false se a entrada esta vazia ou com erro de formato, informado com a linha)
+bool ler(istream& in, const string& nome){
+	int r[3];
+	Leitor leitor(in, nome);
+	if(leitor.vazio()) return false;
+	if(!leitor.quantidade(O, "a quantidade de vertices") || !leitor.campo(D, "o local de origem") || !leitor.campo(F, "o local de destino")) return false;
+	if(!leitor.intervalo(D, O, "origem") || !leitor.intervalo(F, O, "destino")) return false;
+
+	n_rotas = 0;
+	ListaArcos lista;
+
+	//Cada trajeto lido vira um arco (o d w por linha); leituras repetidas sobrescrevem o mesmo arco
+	while(leitor.registro(r, 3)) {
+		if(!leitor.intervalo(r[0], O, "vertice") || !leitor.intervalo(r[1], O, "vertice")) return false;
+		lista.add(r[0], r[1], r[2], 0);
+		n_rotas++;
+	}
+	if(leitor.erro) return false;
+
+	medicao.parar(Medicao::LEITURA);
+	g.montar(O, O, lista);
+	medicao.parar(Medicao::GRAFO);
+	return true;
+}
+
+//Instancia no formato binario (gerada pelo conversor): as colunas de g apontam direto
+//para o arquivo mapeado, sem interpretar os arcos
+bool lerBinario(){
+	if(mapa.problema() != "pcm" || mapa.cab->nPrefixo < 3) {
+		fprintf(stderr, "Arquivo binario nao e uma instancia do PCM (%s)\n", mapa.problema().c_str());
+		return false;
+	}
+	const int* p = mapa.prefixo();
+	O = p[0];
+	D = p[1];
+	F = p[2];
+	if(!mapa.dimensoes(O, O)) return false;
+	if(D < 0 || D >= O || F < 0 || F >= O) {
+		fprintf(stderr, "Arquivo binario corrompido: origem %d ou destino %d fora de 0 a %d\n", D, F, O - 1);
+		return false;
+	}
+	n_rotas = mapa.cab->nRotas;
+	mapa.vista(g);
+	medicao.parar(Medicao::LEITURA);
+	return true;
+}
+
+//Modo de consultas (--queries=arquivo): o grafo (primeira instancia) e lido uma vez e cada linha
+//do arquivo pede distancias a partir dele:
+//   s t   distancia de s a t
+//   s *   de s a todos os vertices
+//   *     tabela completa (todos os pares)
+//Pares com a mesma origem saem de um unico Dijkstra, que para ao fechar o ultimo destino
+//pedido; origens diferentes rodam em paralelo (--threads=), cada thread com heap e vetores
+//de distancia proprios. --query-output=matrix imprime a matriz origens x destinos;
+//paths imprime cada par com o caminho. Com --output=jsonl sai uma linha por par.
+struct Consulta {
+	int origem;
+	vector<int> destinos;	//vazio: todos os vertices
+};
+
+//Le as consultas, agrupadas por origem na ordem da primeira aparicao (false em erro de formato)
+bool lerConsultas(istream& in, const string& nome, vector<Consulta>& consultas){
+	string linha, a, b, resto;
+	long long nLinha = 0;
+	map<int, int> posicao; //origem -> indice em consultas
+	set<pair<int, int>> vistos;
+
+	auto vertice = [&](const string& txt, int& v){
+		char* fim = nullptr;
+		long long x = strtoll(txt.c_str(), &fim, 10);
+		if(txt.empty() || *fim != '\0' || x < 0 || x >= O) {
+			fprintf(stderr, "%s:%lld: vertice invalido \"%s\" (esperado 0 a %d ou *)\n", nome.c_str(), nLinha, txt.c_str(), O - 1);
+			return false;
+		}
+		v = x;
+		return true;
+	};
+	auto pedir = [&](int s, int t){
+		if(!posicao.count(s)) {
+			posicao[s] = consultas.size();
+			consultas.push_back({s, {}});
+			if(t < 0) return;
+			consultas.back().destinos.push_back(t);
+			vistos.insert({s, t});
+			return;
+		}
+		Consulta& c = consultas[posicao[s]];
+		if(c.destinos.empty()) return; //ja pede todos
+		if(t < 0) c.destinos.clear();
+		else if(vistos.insert({s, t}).second) c.destinos.push_back(t);
+	};
+
+	while(getline(in, linha)) {
+		int s, t;
+		nLinha++;
+		istringstream campos(linha.substr(0, linha.find('#')));
+		a = b = resto = "";
+		campos >> a >> b >> resto;
+		if(a.empty()) continue;
+		if(!resto.empty()) {
+			fprintf(stderr, "%s:%lld: consulta com mais de dois campos\n", nome.c_str(), nLinha);
+			return false;
+		}
+		if(a == "*") {
+			if(!b.empty() && b != "*") {
+				fprintf(stderr, "%s:%lld: use \"*\" sozinho para a tabela completa\n", nome.c_str(), nLinha);
+				return false;
+			}
+			for( s = 0; s < O; s++ ) pedir(s, -1);
+			continue;
+		}
+		if(!vertice(a, s)) return false;
+		if(b.empty() || b == "*") pedir(s, -1);
+		else if(vertice(b, t)) pedir(s, t);
+		else return false;
+	}
+	return true;
+}
+
+//Distancias (e caminhos, se pedidos) de uma origem, na ordem dos destinos da consulta
+struct Resposta {
+	vector<long long> dist;
+	vector<vector<int>> caminhos;
+};
+
+void imprimirDistancia(long long d){
+	if(d >= CaminhoMinimo::INF) printf(" %10s", "inf");
+	else printf(" %10lld", d);
+}
+
+//Escreve as respostas de um bloco de origens, na ordem das consultas
+void imprimirBloco(const vector<Consulta>& consultas, int ini, int fim, const vector<Resposta>& respostas, const vector<int>& colunas, const vector<int>& coluna){
+	int i, j;
+	bool caminhos = formatoConsulta == "paths";
+
+	for( i = ini; i < fim; i++ ){
+		const Consulta& c = consultas[i];
+		const Resposta& r = respostas[i - ini];
+		int nDest = c.destinos.empty() ? O : c.destinos.size();
+		if(saida.formato == "jsonl") {
+			for( j = 0; j < nDest; j++ ){
+				int t = c.destinos.empty() ? j : c.destinos[j];
+				printf("{\"origem\":%d,\"destino\":%d,\"distancia\":", c.origem, t);
+				if(r.dist[j] >= CaminhoMinimo::INF) printf("null");
+				else printf("%lld", r.dist[j]);
+				if(caminhos) {
+					printf(",\"caminho\":[");
+					for( size_t p = 0; p < r.caminhos[j].size(); p++ ) printf("%s%d", p ? "," : "", r.caminhos[j][p]);
+					printf("]");
+				}
+				printf("}\n");
+			}
+		}
+		else if(caminhos) {
+			for( j = 0; j < nDest; j++ ){
+				int t = c.destinos.empty() ? j : c.destinos[j];
+				if(r.dist[j] >= CaminhoMinimo::INF) {
+					printf("%d -> %d: sem caminho\n", c.origem, t);
+					continue;
+				}
+				printf("%d -> %d: %lld (caminho:", c.origem, t, r.dist[j]);
+				for( int v : r.caminhos[j] ) printf(" %d", v);
+				printf(")\n");
+			}
+		}
+		else {
+			//Linha da matriz: "-" nas colunas que a origem nao pediu
+			vector<long long> linha(colunas.size(), -1);
+			for( j = 0; j < nDest; j++ ) linha[coluna[c.destinos.empty() ? j : c.destinos[j]]] = r.dist[j];
+			printf("%10d |", c.origem);
+			for( long long d : linha ){
+				if(d < 0) printf(" %10s", "-");
+				else imprimirDistancia(d);
+			}
+			printf("\n");
+		}
+	}
+}
+
+template<class Heap>
+void responder(const vector<Consulta>& consultas){
+	int n = consultas.size(), i;
+	Equipe equipe(nThreads);
+	vector<CaminhoMinimo> cms(equipe.n); //distancias e predecessores de cada thread
+	vector<vector<char>> alvos(equipe.n, vector<char>(O, 0));
+	vector<Resposta> respostas;
+	long long pares = 0;
+
+	//Colunas da matriz: uniao dos destinos pedidos, em ordem crescente
+	vector<int> colunas, coluna(O, -1);
+	if(formatoConsulta == "matrix" && saida.formato != "jsonl") {
+		vector<char> usado(O, 0);
+		for( const Consulta& c : consultas ){
+			if(c.destinos.empty()) fill(usado.begin(), usado.end(), 1);
+			for( int t : c.destinos ) usado[t] = 1;
+		}
+		for( i = 0; i < O; i++ ) if(usado[i]) {
+			coluna[i] = colunas.size();
+			colunas.push_back(i);
+		}
+		printf("%10s |", "origem");
+		for( int t : colunas ) printf(" %10d", t);
+		printf("\n");
+	}
+
+	//Blocos de origens: as threads pegam a proxima origem livre; o bloco sai inteiro e em
+	//ordem antes do seguinte, o que limita a memoria da tabela completa
+	int bloco = max(1, 4 * equipe.n);
+	for( int ini = 0; ini < n; ini += bloco ){
+		int fim = min(n, ini + bloco);
+		atomic<int> prox(ini);
+		respostas.assign(fim - ini, Resposta());
+		medicao.comecar();
+		equipe.executar([&](int id){
+			CaminhoMinimo& cm = cms[id];
+			vector<char>& alvo = alvos[id];
+			int q;
+			while((q = prox++) < fim) {
+				const Consulta& c = consultas[q];
+				Resposta& r = respostas[q - ini];
+				for( int t : c.destinos ) alvo[t] = 1;	//destinos ja vem sem repeticao
+				cm.dijkstraAlvos<Heap>(g, c.origem, alvo, c.destinos.size());
+				for( int t : c.destinos ) alvo[t] = 0;
+				int nDest = c.destinos.empty() ? O : c.destinos.size();
+				r.dist.resize(nDest);
+				if(formatoConsulta == "paths") r.caminhos.resize(nDest);
+				for( int j = 0; j < nDest; j++ ){
+					int t = c.destinos.empty() ? j : c.destinos[j];
+					r.dist[j] = cm.distF[t];
+					if(formatoConsulta == "paths") r.caminhos[j] = cm.vertices(t);
+				}
+			}
+		});
+		medicao.parar(Medicao::RESOLUCAO);
+		imprimirBloco(consultas, ini, fim, respostas, colunas, coluna);
+		medicao.parar(Medicao::SOLUCAO);
+		for( const Resposta& r : respostas ) pares += r.dist.size();
+	}
+	fflush(stdout);
+
+	if(saida.detalhes()) printf("\n#Origens: %d - #Pares: %lld - threads: %d - heap %s - %.6lf seconds\n", n, pares, equipe.n, heap.c_str(), medicao.segundos(Medicao::RESOLUCAO));
+}
+
+void modoConsultas(Lote& lote){
+	vector<Consulta> consultas;
+	istream* in;
+
+	//As consultas valem para um grafo so
+	if(lote.arquivos.size() > 1) {
+		fprintf(stderr, "O modo de consultas le um grafo so: passe um unico arquivo (%d recebidos)\n", (int)lote.arquivos.size());
+		return;
+	}
+	in = lote.proxima();
+	medicao.zerar();
+	if(in == nullptr || !(mapa.abrir(lote.caminho()) ? lerBinario() : !mapa.corrompido && ler(*in, lote.nome))) {
+		fprintf(stderr, "Grafo das consultas vazio ou incompleto\n");
+		return;
+	}
+	if(!CaminhoMinimo::custosValidos(g)) {
+		fprintf(stderr, "Dijkstra exige custos nao negativos\n");
+		return;
+	}
+	ifstream arquivo(arquivoConsultas);
+	if(!arquivo) {
+		fprintf(stderr, "Nao foi possivel abrir %s\n", arquivoConsultas.c_str());
+		return;
+	}
+	if(!lerConsultas(arquivo, arquivoConsultas, consultas)) return;
+	medicao.parar(Medicao::LEITURA);
+
+	if(heap == "radix") responder<HeapRadix>(consultas);
+	else responder<HeapBinario>(consultas);
+
+	if(saida.detalhes()) medicao.imprimir();
+	medicao.registrar(lote.nome, motor, "Optimal");
+	if(lote.proxima() != nullptr) fprintf(stderr, "O modo de consultas le um grafo so: %s e as seguintes foram ignoradas\n", lote.nome.c_str());
+}
+
+//Ligacao com o laco comum de instancias (comum/execucao.h)
+struct PCM : Problema {
+	PCM() : Problema("pcm", {"native"}) {}
+
+	bool argumento(const char* arg) override {
+		if(strncmp(arg, "--heap=", 7) == 0) heap = arg + 7;
+		else if(strcmp(arg, "--bidirectional") == 0) bidirecional = true;
+		else if(strncmp(arg, "--queries=", 10) == 0) arquivoConsultas = arg + 10;
+		else if(strncmp(arg, "--query-output=", 15) == 0) formatoConsulta = arg + 15;
+		else if(strncmp(arg, "--threads=", 10) == 0) nThreads = atoi(arg + 10);
+		else return false;
+		return true;
+	}
+	bool validar() override {
+		if(heap != "binary" && heap != "radix") {
+			fprintf(stderr, "Heap desconhecido: %s (use --heap=binary ou --heap=radix)\n", heap.c_str());
+			return false;
+		}
+		if(arquivoConsultas.empty()) return true;
+		if(formatoConsulta != "matrix" && formatoConsulta != "paths") {
+			fprintf(stderr, "Saida de consultas desconhecida: %s (use --query-output=matrix ou --query-output=paths)\n", formatoConsulta.c_str());
+			return false;
+		}
+		if(motor != "native") {
+			fprintf(stderr, "O modo de consultas so roda com o Dijkstra: use --engine=native\n");
+			return false;
+		}
+		if(saida.formato == "binary") {
+			fprintf(stderr, "O modo de consultas escreve text ou jsonl: use --output=text ou --output=jsonl\n");
+			return false;
+		}
+		if(nThreads <= 0) nThreads = threadsPadrao();
+		return true;
+	}
+	bool ler(istream& in, const string& instancia) override { return pcm::ler(in, instancia); }
+	bool lerBinario() override { return pcm::lerBinario(); }
+	void eco() override {
+		printf("Verificacao da leitura dos dados:\n");
+		printf("Num. de locais: %d\n", O);
+		printf("Num. de rotas: %d\n", n_rotas);
+		printf("origem: id - destino: id - custo\n");
+		for(int k=0; k<g.m; k++) {
+			printf("origem: %d - destino: %d - custo: %d\n", g.origem[k], g.destino[k], g.custo[k]);
+		}
+	}
+	void nativo() override { pcm::nativo(); }
+	bool laco(Lote& lote) override {
+		if(arquivoConsultas.empty()) return false;
+		modoConsultas(lote);
+		return true;
+	}
+#ifndef SEM_CPLEX
+	void cplex() override { pcm::cplex(); }
+	void liberar() override { liberarModelo(); }
+#endif
+};
+
+}
+
+#endif
@@ -0,0 +1,429 @@
+/*---------------- File: pd.h  -------------------------+
+|Modelo PLI - Problema da Designação (PD)               |
+|					      		                        |
+|					      		                        |
+| Implementado por: LUIS ARTHUR DE ASSIS MORAES  	    |
+| 					ALEX DE ANDRADE SOARES  	        |
++-------------------------------------------------------+ */
+
+#ifndef PD_H
+#define PD_H
+
+#include <bits/stdc++.h>
+#include "../comum/execucao.h"
+#include "../comum/designacao.h"
+#include "../comum/k_melhores.h"
+#ifndef SEM_CPLEX
+#include "../comum/matriz_cplex.h"
+#endif
+
+using namespace std;
+
+namespace pd {
+
+//Conjuntos do Problema
+int O; //Quantidade de pessoas
+Grafo g; //Conjunto dos custos (pessoa -> tarefa, custo em g.custo)
+int D; //Quantidade de tarefas 
+int nThreads = 0; //Threads dos motores paralelos (0 = todas as disponiveis)
+bool esparso = false; //--sparse: so os pares listados existem, os ausentes sao proibidos
+bool gargalo = false; //--bottleneck: minimiza o maior custo designado (empate: menor soma)
+int kMelhores = 0; //--k-best=K: as K melhores designacoes distintas, um registro por designacao
+
+#ifndef SEM_CPLEX
+//Modelo do CPLEX mantido entre as instancias do modo lote, carregado em bloco (comum/matriz_cplex.h)
+MatrizCplex matriz;
+vector<int> formaModelo; //Forma do modelo montado (vazia: nenhum)
+int numberVar = 0; //Total de Variaveis
+int numberRes = 0; //Total de Restricoes
+
+//O que define a estrutura do modelo: instancias com a mesma forma reaproveitam o modelo
+vector<int> forma(){
+	vector<int> f = {O, D, esparso};
+	//No modo esparso as colunas sao os pares lidos: a estrutura depende de quais foram
+	if(esparso){
+		f.insert(f.end(), g.origem.begin(), g.origem.end());
+		f.insert(f.end(), g.destino.begin(), g.destino.end());
+	}
+	return f;
+}
+
+void liberarModelo(){
+	matriz.fechar();
+	formaModelo.clear();
+}
+
+//Custos na ordem das colunas (um por par pessoa, tarefa), em paralelo
+void preencherCustos(Equipe& equipe){
+	equipe.paraCada(g.m, [&](int ini, int fim, int){
+		for( int k = ini; k < fim; k++ ) matriz.obj[k] = g.custo[k];
+	});
+}
+
+//Monta o modelo da instancia atual do zero: as colunas sao preenchidas em paralelo em
+//vetores planos e o CPLEX recebe a matriz inteira numa chamada (CPXcopylp)
+void montarModelo(){
+	int i; //Auxiliar
+	Equipe equipe(nThreads);
+
+	//---------- MODELAGEM ---------------
+	//Variaveis de Decisao (x_ij) binárias, uma por par (pessoa, tarefa): a coluna k entra na
+	//restricao da tarefa destino[k] e na da pessoa origem[k]
+	matriz.dimensionar(D + O, g.m, 2, true, equipe);
+	preencherCustos(equipe);
+	equipe.paraCada(g.m, [&](int ini, int fim, int){
+		for( int k = ini; k < fim; k++ ){
+			matriz.ub[k] = 1;
+			matriz.indice[2*k] = g.destino[k];
+			matriz.indice[2*k+1] = D + g.origem[k];
+		}
+	});
+
+	//RESTRICOES: linhas 0..D-1 das tarefas e D..D+O-1 das pessoas, todas == 1
+	for( i = 0; i < D + O; i++ ){
+		matriz.sentido[i] = 'E';
+		matriz.rhs[i] = 1;
+	}
+	numberVar = g.m;
+	numberRes = D + O;
+
+	medicao.parar(Medicao::MODELO);
+	if(!matriz.carregar(CPX_MIN, !relaxacaoLP)) matriz.liberar();
+	medicao.parar(Medicao::EXTRACAO);
+	formaModelo = matriz.lp != nullptr ? forma() : vector<int>();
+}
+
+//Mesma forma do modelo montado: troca so os custos
+void atualizarModelo(){
+	Equipe equipe(nThreads);
+	preencherCustos(equipe);
+	if(!matriz.atualizar()) liberarModelo();
+}
+
+void cplex(){
+	//------ EXECUCAO do MODELO ----------
+	double value, objValue, runTime;
+	string status;
+	bool sol = false;
+	vector<double> valores;
+	int k; //Auxiliar
+
+	medicao.comecar();
+	//Instancia com a mesma forma da anterior: so troca os custos
+	if(formaModelo == forma()) atualizarModelo();
+	else{
+		liberarModelo();
+		montarModelo();
+	}
+	medicao.parar(Medicao::MODELO);
+	
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("#Var: %d\n", numberVar);
+		printf("#Restricoes: %d\n", numberRes);
+		cout << "Memory usage after CPXcopylp (pico RSS):  " << Medicao::mb(Medicao::picoRSS()) << " MB" << endl;
+	}
+
+	if(matriz.lp == nullptr) status = "No Solution";
+	else{
+		matriz.terminar = &corrida.terminar;
+		medicao.comecar();
+		status = matriz.resolver(parametrosCplex, saida.detalhes(), sol, objValue, valores);
+		medicao.parar(Medicao::RESOLUCAO);
+	}
+
+	if(sol){ 
+		runTime = medicao.segundos(Medicao::RESOLUCAO);
+		for( k = 0; k < g.m; k++ ){
+			value = IloRound(valores[k]);
+			if(value != 0) saida.variavel(g.origem[k], g.destino[k], value);
+		}
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(status);
+}
+#endif
+
+//Modo esparso: caminhos aumentantes com Dijkstra so sobre os pares lidos
+void nativoEsparso(){
+	int i; //Auxiliar
+	long long objValue;
+	double runTime;
+	bool sol;
+	ParesDesignacao pares;
+
+	medicao.comecar();
+	pares.carregar(g);
+	DesignacaoEsparsa de(pares);
+	medicao.parar(Medicao::MODELO);
+
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("Motor: caminhos aumentantes com Dijkstra (nativo, esparso)\n");
+		printf("#Pares permitidos: %d\n", g.m);
+		printf("#Pares: %d\n", min(O, D));
+	}
+
+	medicao.comecar();
+	de.parar = &corrida.cancelada;
+	sol = de.resolver();
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+	if(!sol){
+		if(saida.detalhes() && !de.interrompido) printf("Os pares permitidos nao cobrem o lado menor (%s)\n", O > D ? "tarefas" : "pessoas");
+		saida.emitir("No Solution");
+		return;
+	}
+	objValue = de.total();
+
+	vector<int> tarefa = de.tarefas();
+	for( i = 0; i < O; i++ ){
+		if(tarefa[i] >= 0) saida.variavel(i, tarefa[i], 1);
+	}
+	medicao.parar(Medicao::SOLUCAO);
+	saida.solucao(objValue, runTime);
+	saida.emitir("Optimal");
+}
+
+//Designacao de menor gargalo: a FO e o maior custo designado; a soma vai junto no registro
+void nativoGargalo(){
+	int i; //Auxiliar
+	long long limiar;
+	double runTime;
+	bool sol;
+	ParesDesignacao pares;
+
+	medicao.comecar();
+	pares.carregar(g);
+	DesignacaoEsparsa de(pares);
+	medicao.parar(Medicao::MODELO);
+
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("Motor: gargalo por busca binaria com Hopcroft-Karp (nativo%s)\n", esparso ? ", esparso" : "");
+		printf("#Pares permitidos: %d\n", g.m);
+		printf("#Pares: %d\n", min(O, D));
+	}
+
+	medicao.comecar();
+	de.parar = &corrida.cancelada;
+	sol = de.gargalo(limiar);
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+	if(!sol){
+		if(saida.detalhes() && !de.interrompido) printf("Os pares permitidos nao cobrem o lado menor (%s)\n", O > D ? "tarefas" : "pessoas");
+		saida.emitir("No Solution");
+		return;
+	}
+
+	vector<int> tarefa = de.tarefas();
+	for( i = 0; i < O; i++ ){
+		if(tarefa[i] >= 0) saida.variavel(i, tarefa[i], 1);
+	}
+	saida.anexar("Custo total: " + to_string(de.total()) + "\n", "\"custo_total\":" + to_string(de.total()));
+	medicao.parar(Medicao::SOLUCAO);
+	saida.solucao(limiar, runTime);
+	saida.emitir("Optimal");
+}
+
+//K melhores designacoes (ranking de Murty): um registro por designacao, em ordem de custo,
+//com o nome da instancia seguido de #designacao<posicao>
+void nativoKMelhores(){
+	int i; //Auxiliar
+	double runTime;
+	string nome = saida.instancia;
+	ParesDesignacao pares;
+	Equipe equipe(nThreads);
+
+	medicao.comecar();
+	pares.carregar(g);
+	KMelhores km(pares);
+	km.k = kMelhores;
+	km.parar = &corrida.cancelada;
+	medicao.parar(Medicao::MODELO);
+
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("Motor: ranking de Murty (nativo, %d threads)\n", equipe.n);
+		printf("#Pares permitidos: %d\n", g.m);
+		printf("#Designacoes pedidas: %d\n", kMelhores);
+	}
+
+	medicao.comecar();
+	km.resolver(equipe);
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+	if(saida.detalhes()){
+		printf("Particoes avaliadas: %lld\n", km.nFilhas);
+		if(!km.interrompido && (int)km.solucoes.size() < kMelhores) printf("So ha %d designacoes distintas\n", (int)km.solucoes.size());
+	}
+	if(km.solucoes.empty()){
+		saida.emitir("No Solution");
+		return;
+	}
+
+	for( size_t r = 0; r < km.solucoes.size(); r++ ){
+		if(saida.texto()) printf("==== Designacao %d ====\n", (int)r + 1);
+		saida.iniciar(nome + "#designacao" + to_string(r + 1));
+		vector<int> tarefa = pares.tarefas(km.solucoes[r].col);
+		for( i = 0; i < O; i++ ){
+			if(tarefa[i] >= 0) saida.variavel(i, tarefa[i], 1);
+		}
+		saida.solucao(km.solucoes[r].custo, runTime);
+		saida.emitir("Optimal");
+	}
+	medicao.parar(Medicao::SOLUCAO);
+	saida.instancia = nome;
+}
+
+//Resolve com o Hungaro (native) ou com o leilao paralelo (auction), imprimindo no mesmo formato do cplex()
+//Com O != D sao designados min(O, D) pares: cada elemento do lado menor exatamente uma vez.
+void nativo(){
+	int i; //Auxiliar
+	long long objValue;
+	double runTime;
+	Designacao dg;
+
+	if(gargalo){
+		nativoGargalo();
+		return;
+	}
+	if(kMelhores > 0){
+		nativoKMelhores();
+		return;
+	}
+	if(esparso){
+		nativoEsparso();
+		return;
+	}
+	medicao.comecar();
+	dg.carregar(g);
+	medicao.parar(Medicao::MODELO);
+
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		if(motor == "auction") printf("Motor: leilao (nativo, %d threads)\n", nThreads);
+		else printf("Motor: hungaro (nativo)\n");
+		printf("#Pares: %d\n", min(O, D));
+	}
+
+	medicao.comecar();
+	if(motor == "auction") objValue = dg.leilao(nThreads);
+	else objValue = dg.hungaro();
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+
+	vector<int> tarefa = dg.tarefas();
+	for( i = 0; i < O; i++ ){
+		if(tarefa[i] >= 0) saida.variavel(i, tarefa[i], 1);
+	}
+	medicao.parar(Medicao::SOLUCAO);
+	saida.solucao(objValue, runTime);
+	saida.emitir("Optimal");
+}
+
+
+//Le uma instancia (false se a entrada esta vazia ou com erro de formato, informado com a linha)
+bool ler(istream& in, const string& nome){
+	int i, r[3];
+	Leitor leitor(in, nome);
+	if(leitor.vazio()) return false;
+	if(!leitor.quantidade(O, "a quantidade de pessoas") || !leitor.quantidade(D, "a quantidade de tarefas")) return false;
+
+	ListaArcos lista;
+
+	//Todos os pares existem; os nao informados tem custo 0 (no modo esparso nao existem)
+	for(i=0; i<O && !esparso; i++) {
+		for(int l=0; l<D; l++) {
+			lista.add(i, l, 0, 0);
+		}	
+	}
+
+	while(leitor.registro(r, 3)) {
+		if(!leitor.intervalo(r[0], O, "pessoa") || !leitor.intervalo(r[1], D, "tarefa")) return false;
+		lista.add(r[0], r[1], r[2], 0);
+	}
+	if(leitor.erro) return false;
+
+	medicao.parar(Medicao::LEITURA);
+	g.montar(O, D, lista);
+	medicao.parar(Medicao::GRAFO);
+	return true;
+}
+
+//Instancia no formato binario (gerada pelo conversor): as colunas de g apontam direto
+//para o arquivo mapeado, sem interpretar os arcos
+bool lerBinario(){
+	if(mapa.problema() != "pd" || mapa.cab->nPrefixo < 2) {
+		fprintf(stderr, "Arquivo binario nao e uma instancia do PD (%s)\n", mapa.problema().c_str());
+		return false;
+	}
+	const int* p = mapa.prefixo();
+	O = p[0];
+	D = p[1];
+	if(!mapa.dimensoes(O, D)) return false;
+	mapa.vista(g);
+	medicao.parar(Medicao::LEITURA);
+	return true;
+}
+
+//Ligacao com o laco comum de instancias (comum/execucao.h)
+struct PD : Problema {
+	PD() : Problema("pd", {"native", "auction"}) {}
+
+	bool argumento(const char* arg) override {
+		if(strcmp(arg, "--sparse") == 0) esparso = true;
+		else if(strcmp(arg, "--bottleneck") == 0) gargalo = true;
+		else if(strncmp(arg, "--k-best=", 9) == 0) {
+			kMelhores = atoi(arg + 9);
+			if(kMelhores < 1) kMelhores = -1; //invalido: validar() recusa
+		}
+		else if(strncmp(arg, "--threads=", 10) == 0) nThreads = atoi(arg + 10);
+		else return false;
+		return true;
+	}
+	bool validar() override {
+		if(nThreads <= 0) nThreads = threadsPadrao();
+		//O leilao trabalha sobre a matriz densa: no modo esparso sai tambem da corrida
+		if(esparso) corrida.motores.erase(remove(corrida.motores.begin(), corrida.motores.end(), "auction"), corrida.motores.end());
+		if(esparso && (motor == "auction" || (motor == "portfolio" && corrida.motores.empty()))) {
+			fprintf(stderr, "O modo esparso resolve com --engine=native (caminhos aumentantes) ou --engine=cplex\n");
+			return false;
+		}
+		if(kMelhores < 0) {
+			fprintf(stderr, "--k-best precisa ser ao menos 1\n");
+			return false;
+		}
+		if((gargalo || kMelhores > 0) && (motor != "native" || (gargalo && kMelhores > 0))) {
+			fprintf(stderr, "O gargalo e os k melhores sao modos do motor nativo, um de cada vez: use --engine=native com --bottleneck ou --k-best=K\n");
+			return false;
+		}
+		return true;
+	}
+	bool ler(istream& in, const string& instancia) override { return pd::ler(in, instancia); }
+	bool lerBinario() override { return pd::lerBinario(); }
+	void eco() override {
+		printf("Verificacao da leitura dos dados:\n");
+		printf("Num. de funcionarios: %d\n", O);
+		printf("Num. de tarefas: %d\n", D);
+		printf("funcionario: id - tarefa: id - valor\n");
+		for(int k=0; k<g.m; k++) {
+			printf("individuo: %d - tarefa: %d - custo: %d\n", g.origem[k], g.destino[k], g.custo[k]);
+		}
+	}
+	void nativo() override { pd::nativo(); }
+#ifndef SEM_CPLEX
+	void cplex() override { pd::cplex(); }
+	void liberar() override { liberarModelo(); }
+#endif
+};
+
+}
+
+#endif
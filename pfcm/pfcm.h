@@ -0,0 +1,657 @@
+/*---------------- File: pfcm.h  -----------------------+
+|Modelo PLI - Problema de Fluxo de Custo Mínimo (PFCM)  |
+|					      		                        |
+|					      		                        |
+| Implementado por: LUIS ARTHUR DE ASSIS MORAES  	    |
+| 					ALEX DE ANDRADE SOARES  	        |
++-------------------------------------------------------+ */
+
+#ifndef PFCM_H
+#define PFCM_H
+
+#include <bits/stdc++.h>
+#include "../comum/execucao.h"
+#include "../comum/custo_minimo.h"
+#include "../comum/multiproduto.h"
+
+using namespace std;
+
+namespace pfcm {
+
+struct vertice {
+    int id, w; //id do vertice, e necessidade/recursos
+};
+
+//Conjuntos do Problema
+int O; //Quantidade de origens
+vector<vertice> origens; //Conjunto das origens
+vector<vertice> sobras; //Conjunto dos locais de passagem
+vector<vertice> demandas; //Conjunto dos locais de demanda
+Grafo g; //Conjunto dos caminhos (custo em g.custo, capacidade em g.cap)
+int n_rotas = 0; //Quantidade de rotas lidas (repeticoes incluidas)
+int D; //Quantidade de demandas
+int F;	//Quantidade de locais de passagem
+bool incremental = false; //Modo incremental: atualizacoes de arcos em stdin apos a instancia inicial
+string arquivoProdutos; //Modo multiproduto (--commodities=arquivo): produtos que dividem as capacidades com a instancia
+vector<vector<vertice>> ofertasProduto, pedidosProduto; //Origens e demandas de cada produto do arquivo
+int maxIteracoes = 300; //Iteracoes do subgradiente no modo multiproduto (--lagrange-iters=)
+int nThreads = 0; //Threads dos subproblemas do modo multiproduto (0 = todas as disponiveis)
+
+#ifndef SEM_CPLEX
+//Modelo do CPLEX mantido entre as instancias do modo lote
+IloModel model;
+IloNumVarArray x; //Variaveis de decisao, uma por arco
+IloObjective fo;
+IloRangeArray resOrigens, resDemandas, resSobras; //Restricoes cujo lado direito muda entre instancias
+IloCplex solverCplex;
+vector<int> formaModelo; //Forma do modelo montado (vazia: nenhum)
+IloNumArray incumbente; //Ultima solucao, usada como MIP start no modo incremental
+bool temIncumbente = false;
+bool modeloEmDia = false; //aplicarAlteracoes() ja levou as mudancas ao modelo
+int numberVar = 0; //Total de Variaveis
+int numberRes = 0; //Total de Restricoes
+
+//O que define a estrutura do modelo: instancias com a mesma forma reaproveitam o modelo
+vector<int> forma(){
+	int i; //Auxiliar
+	vector<int> f = {O, D, F};
+	for( i = 0; i < O; i++ ) f.push_back(origens[i].id);
+	for( i = 0; i < D; i++ ) f.push_back(demandas[i].id);
+	for( i = 0; i < F; i++ ) f.push_back(sobras[i].id);
+	f.insert(f.end(), g.origem.begin(), g.origem.end());
+	f.insert(f.end(), g.destino.begin(), g.destino.end());
+	return f;
+}
+
+void liberarModelo(){
+	if(formaModelo.empty()) return;
+	solverCplex.end();
+	model.end();
+	fo.end();
+	resOrigens.endElements();
+	resOrigens.end();
+	resDemandas.endElements();
+	resDemandas.end();
+	resSobras.endElements();
+	resSobras.end();
+	incumbente.end();
+	x.endElements();
+	x.end();
+	formaModelo.clear();
+}
+
+//Monta o modelo da instancia atual do zero
+void montarModelo(){
+	int i, k; //Auxiliares
+	numberVar = 0;
+	numberRes = 0;
+
+
+	//---------- MODELAGEM ---------------
+	//Definicao - Variaveis de Decisao (x_ij) não binárias (discretas), uma por arco lido,
+	//com a capacidade como limite superior da variavel
+	x = IloNumVarArray(env);
+	for( k = 0; k < g.m; k++ ){
+		x.add(IloNumVar(env, 0, g.cap[k], relaxacaoLP ? ILOFLOAT : ILOINT));
+		numberVar++;
+	}
+
+	//Definicao do ambiente modelo ------------------------------------------
+	model = IloModel(env);
+	
+	//Definicao do ambiente expressoes, para os somatorios ---------------------------------
+	IloExpr sum(env); /// Expression for Sum
+	IloExpr sum2(env); /// Expression for Sum2
+
+	//FUNCAO OBJETIVO ---------------------------------------------
+	sum.clear();
+	for( k = 0; k < g.m; k++ ){
+		sum += (g.custo[k] * x[k]);
+	}
+
+	//Modelo de Minimizacao
+	fo = IloMinimize(env, sum);
+	model.add(fo); //Minimizacao
+
+	//RESTRICOES ---------------------------------------------	
+	 
+	//Resstrições de origem
+	resOrigens = IloRangeArray(env);
+	for( i = 0; i < O; i++ ){
+		sum.clear();
+		for( k = g.inicio[origens[i].id]; k < g.inicio[origens[i].id+1]; k++ ){
+			sum += x[k];
+		}
+		for( k = g.inicioInv[origens[i].id]; k < g.inicioInv[origens[i].id+1]; k++ ){
+			sum -= x[g.arcoInv[k]];
+		}
+		resOrigens.add(sum <= origens[i].w); 
+		numberRes++;
+	}
+	model.add(resOrigens);
+
+	//Resstrições das demandas
+	resDemandas = IloRangeArray(env);
+	for( i = 0; i < D; i++ ){
+		sum.clear();
+		for( k = g.inicioInv[demandas[i].id]; k < g.inicioInv[demandas[i].id+1]; k++ ){
+			sum += x[g.arcoInv[k]];
+		}
+		for( k = g.inicio[demandas[i].id]; k < g.inicio[demandas[i].id+1]; k++ ){
+			sum -= x[k];
+		}
+		resDemandas.add(sum >= demandas[i].w); 
+		numberRes++;
+	}
+	model.add(resDemandas);
+
+	//Resstrições de locais de passagem
+	resSobras = IloRangeArray(env);
+	for( i = 0; i < F; i++ ){
+		sum.clear();
+		for( k = g.inicioInv[sobras[i].id]; k < g.inicioInv[sobras[i].id+1]; k++ ){
+			sum += x[g.arcoInv[k]];
+		}
+		for( k = g.inicio[sobras[i].id]; k < g.inicio[sobras[i].id+1]; k++ ){
+			sum -= x[k];
+		}
+		resSobras.add(sum == sobras[i].w); 
+		numberRes++;
+	}
+	model.add(resSobras);
+
+	medicao.parar(Medicao::MODELO);
+	solverCplex = IloCplex(model); //extracao do modelo para o CPLEX
+	medicao.parar(Medicao::EXTRACAO);
+	formaModelo = forma();
+	incumbente = IloNumArray(env, g.m);
+	temIncumbente = false;
+
+	sum.end();
+	sum2.end();
+}
+
+//Mesma forma do modelo montado: troca so coeficientes e lados direitos
+void atualizarModelo(){
+	int i, k; //Auxiliares
+	IloNumArray custos(env, g.m);
+
+	for( k = 0; k < g.m; k++ ) custos[k] = g.custo[k];
+	fo.setLinearCoefs(x, custos);
+	custos.end();
+	for( i = 0; i < O; i++ ) resOrigens[i].setUB(origens[i].w);
+	for( i = 0; i < D; i++ ) resDemandas[i].setLB(demandas[i].w);
+	for( i = 0; i < F; i++ ) resSobras[i].setBounds(sobras[i].w, sobras[i].w);
+	for( k = 0; k < g.m; k++ ) x[k].setUB(g.cap[k]);
+}
+
+//Modo incremental: so os arcos alterados mudam no modelo. A base do LP anterior fica no
+//CPLEX, e no MIP a solucao anterior entra como MIP start (reparada se violar as novas capacidades).
+void aplicarAlteracoes(const vector<int>& alterados){
+	for( int k : alterados ){
+		fo.setLinearCoef(x[k], g.custo[k]);
+		x[k].setUB(g.cap[k]);
+	}
+	if(solverCplex.getNMIPStarts() > 0) solverCplex.deleteMIPStarts(0, solverCplex.getNMIPStarts());
+	if(temIncumbente && !relaxacaoLP) solverCplex.addMIPStart(x, incumbente, IloCplex::MIPStartRepair);
+	modeloEmDia = true;
+}
+
+void cplex(){
+	//------ EXECUCAO do MODELO ----------
+	IloNum value, objValue;
+	double runTime;
+	string status;
+	bool sol;
+	int k; //Auxiliar
+
+	medicao.comecar();
+	//Instancia com a mesma forma da anterior: so troca coeficientes e lados direitos
+	if(modeloEmDia) modeloEmDia = false;
+	else if(formaModelo == forma()) atualizarModelo();
+	else{
+		liberarModelo();
+		montarModelo();
+	}
+	medicao.parar(Medicao::MODELO);
+	IloCplex cplex = solverCplex;
+	
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("#Var: %d\n", numberVar);
+		printf("#Restricoes: %d\n", numberRes);
+		memoriaCplex("after variable creation");
+	
+		memoriaCplex("after cplex(Model)");
+	}
+
+	status = resolverCplex(cplex, sol);
+
+	if(sol){ 
+
+		//Results
+		//int Nbin, Nint, Ncols, Nrows, Nnodes, Nnodes64;
+		objValue = cplex.getObjValue();
+		runTime = medicao.segundos(Medicao::RESOLUCAO);
+		cplex.getValues(incumbente, x); //todos os valores numa chamada so
+		temIncumbente = true;
+		//Informacoes Adicionais
+		//Nbin = cplex.getNbinVars();
+		//Nint = cplex.getNintVars();
+		//Ncols = cplex.getNcols();
+		//Nrows = cplex.getNrows();
+		//Nnodes = cplex.getNnodes();
+		//Nnodes64 = cplex.getNnodes64();
+		//float gap; gap = cplex.getMIPRelativeGap();
+		
+		for( k = 0; k < g.m; k++ ){
+			value = IloRound(incumbente[k]);
+			if(value != 0) saida.variavel(g.origem[k], g.destino[k], value);
+		}
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(status);
+
+	if(saida.detalhes()) memoriaCplex("before end");
+}
+#endif
+
+CustoMinimo rede; //Rede do motor nativo, mantida entre as atualizacoes do modo incremental
+bool redeQuente = false; //A arvore da ultima solucao continua viavel: reotimiza em vez de resolver
+
+//Mesmos vertices e arcos do modelo, mais um vertice extra r. A sobra de cada
+//origem e o que cada demanda recebe alem do pedido seguem para r, entao as
+//desigualdades do modelo viram ofertas exatas. Locais fora das listas ficam
+//equilibrados como os de passagem. Os arcos 0..g.m-1 da rede sao os de g.
+void montarRede(CustoMinimo& cm, const vector<vertice>& ofertas, const vector<vertice>& pedidos, const vector<vertice>& passagem){
+	int i, k, r; //Auxiliares
+	long long soma = 0;
+
+	for( i = 0; i < g.n; i++ ) cm.addNo(0);
+	r = cm.addNo(0);
+	for( k = 0; k < g.m; k++ ) cm.addArco(g.origem[k], g.destino[k], g.cap[k], g.custo[k]);
+	for( const vertice& v : ofertas ){
+		cm.oferta[v.id] += v.w;
+		cm.addArco(v.id, r, CustoMinimo::INF, 0);
+	}
+	for( const vertice& v : pedidos ){
+		cm.oferta[v.id] -= v.w;
+		cm.addArco(v.id, r, CustoMinimo::INF, 0);
+	}
+	for( const vertice& v : passagem ){
+		cm.oferta[v.id] -= v.w;
+	}
+	for( i = 0; i < r; i++ ) soma += cm.oferta[i];
+	cm.oferta[r] = -soma;
+}
+
+void montarRede(){
+	rede = CustoMinimo();
+	montarRede(rede, origens, demandas, sobras);
+}
+
+//Resolve com o simplex de redes nativo, imprimindo no mesmo formato do cplex()
+void nativo(){
+	int k; //Auxiliar
+	long long value, objValue;
+	double runTime;
+	string status;
+	CustoMinimo& cm = rede;
+	bool quente = redeQuente;
+
+	medicao.comecar();
+	if(!quente) montarRede();
+	cm.parar = &corrida.cancelada;
+	medicao.parar(Medicao::MODELO);
+	redeQuente = false;
+
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("Motor: simplex de redes (nativo%s)\n", quente ? ", a partir da base anterior" : "");
+		printf("#Arcos: %d\n", cm.m);
+	}
+
+	medicao.comecar();
+	bool sol = ((quente ? cm.reotimizar() : cm.resolver()) == CustoMinimo::OTIMO);
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+
+	status = sol ? "Optimal" : "No Solution";
+	if(sol){
+		objValue = cm.custoTotal();
+		for( k = 0; k < g.m; k++ ){
+			value = cm.fluxo[k];
+			if(value != 0) saida.variavel(g.origem[k], g.destino[k], value);
+		}
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(status);
+}
+
+
+//Le uma instancia (false se a entrada esta vazia ou com erro de formato, informado com a linha)
+bool ler(istream& in, const string& nome){
+	int i, r[4];
+	Leitor leitor(in, nome);
+	if(leitor.vazio()) return false;
+	if(!leitor.quantidade(O, "a quantidade de origens") || !leitor.quantidade(D, "a quantidade de demandas") || !leitor.quantidade(F, "a quantidade de locais de passagem")) return false;
+
+	int N = O + D + F;
+	n_rotas = 0;
+	origens.assign(O, vertice());
+	demandas.assign(D, vertice());
+	sobras.assign(F, vertice());
+	ListaArcos lista;
+
+	for(i=0; i<O; i++){
+		if(!leitor.campo(origens[i].id, "as origens") || !leitor.intervalo(origens[i].id, N, "origem") || !leitor.campo(origens[i].w, "as origens")) return false;
+	} 
+	for(i=0; i<D; i++){
+		if(!leitor.campo(demandas[i].id, "as demandas") || !leitor.intervalo(demandas[i].id, N, "demanda") || !leitor.campo(demandas[i].w, "as demandas")) return false;
+	}
+	for(i=0; i<F; i++){
+		if(!leitor.campo(sobras[i].id, "os locais de passagem") || !leitor.intervalo(sobras[i].id, N, "local de passagem")) return false;
+	}
+	//Cada caminho lido vira um arco (o d custo capacidade por linha); leituras repetidas sobrescrevem o mesmo arco
+	while(leitor.registro(r, 4)) {
+		if(!leitor.intervalo(r[0], N, "vertice") || !leitor.intervalo(r[1], N, "vertice")) return false;
+		lista.add(r[0], r[1], r[2], r[3]);
+		n_rotas++;
+	}
+	if(leitor.erro) return false;
+
+	medicao.parar(Medicao::LEITURA);
+	g.montar(N, N, lista);
+	//No modo incremental os arcos sem capacidade ficam, pois podem ganhar capacidade depois
+	if(!incremental) g.removerSemCapacidade();
+	medicao.parar(Medicao::GRAFO);
+	return true;
+}
+
+//Instancia no formato binario (gerada pelo conversor): as colunas de g apontam direto
+//para o arquivo mapeado, sem interpretar os arcos
+bool lerBinario(){
+	int i;
+	if(mapa.problema() != "pfcm" || mapa.cab->nPrefixo < 3) {
+		fprintf(stderr, "Arquivo binario nao e uma instancia do PFCM (%s)\n", mapa.problema().c_str());
+		return false;
+	}
+	const int* p = mapa.prefixo();
+	O = p[0];
+	D = p[1];
+	F = p[2];
+	int64_t N = (int64_t)O + D + F;
+	if(O < 0 || D < 0 || F < 0 || !mapa.dimensoes(N, N)) return false;
+	if(mapa.cab->nPrefixo != 3 + 2*(int64_t)O + 2*(int64_t)D + F) {
+		fprintf(stderr, "Arquivo binario corrompido: esperados %d origens, %d demandas e %d locais de passagem no prefixo\n", O, D, F);
+		return false;
+	}
+	origens.assign(O, vertice());
+	demandas.assign(D, vertice());
+	sobras.assign(F, vertice());
+	p += 3;
+	for(i=0; i<O; i++, p += 2){
+		origens[i].id = p[0];
+		origens[i].w = p[1];
+	}
+	for(i=0; i<D; i++, p += 2){
+		demandas[i].id = p[0];
+		demandas[i].w = p[1];
+	}
+	for(i=0; i<F; i++) sobras[i].id = *p++;
+	bool fora = false;
+	for(i=0; i<O; i++) fora |= origens[i].id < 0 || origens[i].id >= N;
+	for(i=0; i<D; i++) fora |= demandas[i].id < 0 || demandas[i].id >= N;
+	for(i=0; i<F; i++) fora |= sobras[i].id < 0 || sobras[i].id >= N;
+	if(fora) {
+		fprintf(stderr, "Arquivo binario corrompido: vertice fora de 0 a %lld no prefixo\n", (long long)N - 1);
+		return false;
+	}
+	n_rotas = mapa.cab->nRotas;
+	mapa.vista(g);
+	medicao.parar(Medicao::LEITURA);
+	if(!incremental) g.removerSemCapacidade();
+	medicao.parar(Medicao::GRAFO);
+	return true;
+}
+
+
+//Modo incremental: resolve a instancia inicial (primeiro caminho da linha de comando ou
+//bloco de stdin ate "---") e depois le de stdin atualizacoes "o d w c", novo custo e nova
+//capacidade do arco o -> d. Cada linha em branco, e o fim da entrada, re-resolve.
+void modoIncremental(Problema& p, Lote& lote){
+	int o, d, w, c, k, rodada = 0;
+	vector<int> alterados;
+	string linha;
+	istream* in = lote.proxima();
+
+	medicao.zerar();
+	//Instancia binaria: o mapeamento e privado, entao as capacidades podem mudar na memoria
+	if(in == nullptr || !(mapa.abrir(lote.caminho()) ? lerBinario() : !mapa.corrompido && ler(*in, lote.nome))) {
+		fprintf(stderr, "Instancia inicial vazia ou incompleta\n");
+		return;
+	}
+	if(saida.texto()) lote.cabecalho();
+	saida.iniciar(lote.nome);
+	resolver(p);
+
+	while(true) {
+		bool fim = !getline(cin, linha);
+		if(!fim && linha.find_first_not_of(" \t\r") != string::npos) {
+			istringstream campos(linha);
+			if(!(campos >> o >> d >> w >> c) || c < 0 || !(campos >> ws).eof()) {
+				fprintf(stderr, "Atualizacao ignorada (esperado: o d w c, com c >= 0): %s\n", linha.c_str());
+				continue;
+			}
+			k = (o >= 0 && o < g.n) ? g.arco(o, d) : -1;
+			if(k < 0) {
+				fprintf(stderr, "Arco %d -> %d nao existe na rede: atualizacao ignorada\n", o, d);
+				continue;
+			}
+			g.custo[k] = w;
+			g.cap[k] = c;
+			alterados.push_back(k);
+			continue;
+		}
+
+		if(!alterados.empty()) {
+			sort(alterados.begin(), alterados.end());
+			alterados.erase(unique(alterados.begin(), alterados.end()), alterados.end());
+			rodada++;
+			if(saida.texto()) printf("==== Atualizacao %d: %d arcos alterados ====\n", rodada, (int)alterados.size());
+			saida.iniciar(lote.nome + "#" + to_string(rodada));
+			medicao.zerar();
+			if(motor == "native") {
+				bool quente = true;
+				for( int e : alterados ) quente = rede.alterarArco(e, g.cap[e], g.custo[e]) && quente;
+				redeQuente = quente;
+			}
+#ifndef SEM_CPLEX
+			else aplicarAlteracoes(alterados);
+#endif
+			resolver(p);
+			alterados.clear();
+		}
+		if(fim) break;
+	}
+}
+
+//Arquivo de produtos (--commodities=arquivo): para cada produto, "O D" e depois O linhas
+//"id oferta" e D linhas "id demanda", com o mesmo sentido do cabecalho da instancia.
+//A propria instancia e o produto 0; todos dividem as capacidades dos arcos.
+bool lerProdutos(){
+	int nO, nD, k = 0;
+	ifstream arquivo(arquivoProdutos);
+	if(!arquivo) {
+		fprintf(stderr, "Nao foi possivel abrir %s\n", arquivoProdutos.c_str());
+		return false;
+	}
+	Leitor leitor(arquivo, arquivoProdutos);
+	ofertasProduto.clear();
+	pedidosProduto.clear();
+	while(leitor.inteiro(nO)) {
+		k++;
+		if(nO < 0) return leitor.falha(leitor.linha, "quantidade de origens negativa no produto %d", k);
+		if(!leitor.quantidade(nD, "a quantidade de demandas do produto")) return false;
+		vector<vertice> ofertas(nO), pedidos(nD);
+		for( vertice& v : ofertas ) if(!leitor.campo(v.id, "as origens do produto") || !leitor.campo(v.w, "as origens do produto")) return false;
+		for( vertice& v : pedidos ) if(!leitor.campo(v.id, "as demandas do produto") || !leitor.campo(v.w, "as demandas do produto")) return false;
+		ofertasProduto.push_back(ofertas);
+		pedidosProduto.push_back(pedidos);
+	}
+	return !leitor.erro;
+}
+
+//Modo multiproduto: cada instancia do lote e resolvida por relaxacao lagrangiana das
+//capacidades conjuntas (comum/multiproduto.h). Sai um registro por produto ("#produto k")
+//e um da instancia com o fluxo total de cada arco.
+void modoMultiproduto(Lote& lote){
+	istream* in;
+	int k, e; //Auxiliares
+	Equipe equipe(nThreads);
+
+	while((in = lote.proxima()) != nullptr) {
+		medicao.zerar();
+		if(saida.texto()) lote.cabecalho();
+		if(!(mapa.abrir(lote.caminho()) ? lerBinario() : !mapa.corrompido && ler(*in, lote.nome))) {
+			fprintf(stderr, "Instancia %s vazia ou incompleta\n", lote.nome.c_str());
+			continue;
+		}
+		bool ids = true;
+		for( k = 0; k < (int)ofertasProduto.size(); k++ ){
+			for( const vertice& v : ofertasProduto[k] ) ids = ids && v.id >= 0 && v.id < g.n;
+			for( const vertice& v : pedidosProduto[k] ) ids = ids && v.id >= 0 && v.id < g.n;
+		}
+		if(!ids) {
+			fprintf(stderr, "%s: produto com vertice fora do intervalo [0, %d) da instancia %s\n", arquivoProdutos.c_str(), g.n, lote.nome.c_str());
+			continue;
+		}
+		if(saida.detalhes()) {
+			printf("Verificacao da leitura dos dados:\n");
+			printf("Num. de produtos: %d\n", (int)ofertasProduto.size() + 1);
+			printf("Num. de rotas: %d\n\n", n_rotas);
+		}
+
+		MultiProduto mp;
+		mp.m = g.m;
+		mp.maxIteracoes = maxIteracoes;
+		mp.redes.resize(ofertasProduto.size() + 1);
+		montarRede(mp.redes[0], origens, demandas, sobras);
+		for( k = 1; k < mp.produtos(); k++ ) montarRede(mp.redes[k], ofertasProduto[k-1], pedidosProduto[k-1], {});
+		medicao.parar(Medicao::MODELO);
+
+		if(saida.detalhes()){
+			printf("--------Informacoes da Execucao:----------\n\n");
+			printf("Motor: relaxacao lagrangiana com simplex de redes por produto (nativo, %d threads)\n", equipe.n);
+			printf("#Produtos: %d - #Arcos compartilhados: %d\n", mp.produtos(), mp.m);
+		}
+
+		MultiProduto::Status st = mp.resolver(equipe);
+		medicao.parar(Medicao::RESOLUCAO);
+		double runTime = medicao.segundos(Medicao::RESOLUCAO);
+		bool sol = st == MultiProduto::OTIMO || st == MultiProduto::VIAVEL;
+		string status = st == MultiProduto::OTIMO ? "Optimal" : sol ? "Feasible" : "No Solution";
+
+		if(saida.detalhes()){
+			printf("Iteracoes: %d - pivos: %lld\n", mp.iteracoes, mp.nPivos);
+			if(st == MultiProduto::INVIAVEL) printf("Algum produto nao cabe na rede nem sozinho\n");
+			else printf("Limite inferior: %.3lf\n", mp.limite);
+			if(sol) printf("Gap: %.4lf%%\n", 100.0 * (mp.melhorCusto - mp.limite) / max(1.0, fabs((double)mp.melhorCusto)));
+		}
+
+		if(sol){
+			//Um registro por produto e o do fluxo total
+			vector<long long> total(g.m, 0);
+			for( k = 0; k < mp.produtos(); k++ ){
+				if(saida.texto()) printf("==== Produto %d ====\n", k);
+				saida.iniciar(lote.nome + "#produto" + to_string(k));
+				for( e = 0; e < g.m; e++ ){
+					total[e] += mp.melhor[k][e];
+					if(mp.melhor[k][e] != 0) saida.variavel(g.origem[e], g.destino[e], mp.melhor[k][e]);
+				}
+				saida.solucao(mp.custoProduto[k], runTime);
+				saida.emitir(status);
+			}
+			if(saida.texto()) printf("==== Total ====\n");
+			saida.iniciar(lote.nome);
+			for( e = 0; e < g.m; e++ ) if(total[e] != 0) saida.variavel(g.origem[e], g.destino[e], total[e]);
+			saida.solucao(mp.melhorCusto, runTime);
+		}
+		else saida.iniciar(lote.nome);
+		medicao.parar(Medicao::SOLUCAO);
+		saida.emitir(status);
+
+		if(saida.detalhes()) medicao.imprimir();
+		char buf[160];
+		snprintf(buf, sizeof(buf), "\"produtos\":%d,\"iteracoes\":%d,\"limite_inferior\":%.17g", mp.produtos(), mp.iteracoes, mp.limite);
+		medicao.parametros = buf;
+		medicao.registrar(lote.nome, motor, status);
+	}
+}
+
+//Ligacao com o laco comum de instancias (comum/execucao.h)
+struct PFCM : Problema {
+	PFCM() : Problema("pfcm", {"native"}) {}
+
+	bool argumento(const char* arg) override {
+		if(strcmp(arg, "--incremental") == 0) incremental = true;
+		else if(strncmp(arg, "--commodities=", 14) == 0) arquivoProdutos = arg + 14;
+		else if(strncmp(arg, "--lagrange-iters=", 17) == 0) maxIteracoes = atoi(arg + 17);
+		else if(strncmp(arg, "--threads=", 10) == 0) nThreads = atoi(arg + 10);
+		else return false;
+		return true;
+	}
+	bool validar() override {
+		if(incremental && motor == "portfolio") {
+			fprintf(stderr, "O modo incremental reaproveita a base de um motor so: use --engine=cplex ou --engine=native\n");
+			return false;
+		}
+		if(arquivoProdutos.empty()) return true;
+		if(motor != "native" || incremental) {
+			fprintf(stderr, "O modo multiproduto decompoe por produto com o simplex de redes: use --engine=native, sem --incremental\n");
+			return false;
+		}
+		if(maxIteracoes < 1) {
+			fprintf(stderr, "--lagrange-iters precisa ser ao menos 1\n");
+			return false;
+		}
+		if(nThreads <= 0) nThreads = threadsPadrao();
+		return lerProdutos();
+	}
+	bool ler(istream& in, const string& instancia) override { return pfcm::ler(in, instancia); }
+	bool lerBinario() override { return pfcm::lerBinario(); }
+	void eco() override {
+		printf("Verificacao da leitura dos dados:\n");
+		printf("Num. de locais de origem: %d\n", O);
+		printf("Num. de locais de demanda: %d\n", D);
+		printf("Num. de locais de caminho: %d\n", F);
+		printf("Num. de rotas: %d\n", n_rotas);
+		printf("origem: id - destino: id - custo - capacidade\n");
+		for(int k=0; k<g.m; k++) {
+			if(g.cap[k] != 0) printf("origem: %d - destino: %d - custo: %d - capacidade: %d\n", g.origem[k], g.destino[k], g.custo[k], g.cap[k]);
+		}
+	}
+	void nativo() override { pfcm::nativo(); }
+#ifndef SEM_CPLEX
+	void cplex() override { pfcm::cplex(); }
+	void liberar() override { liberarModelo(); }
+#endif
+	bool laco(Lote& lote) override {
+		if(!arquivoProdutos.empty()) {
+			modoMultiproduto(lote);
+			return true;
+		}
+		if(!incremental) return false;
+		lote.ativo = true;
+		modoIncremental(*this, lote);
+		return true;
+	}
+};
+
+}
+
+#endif
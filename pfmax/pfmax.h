@@ -0,0 +1,495 @@
+/*---------------- File: pfmax.h  ----------------------+
+|Modelo PLI - Problema de Fluxo Máximo (PFM)            |
+|					      		                        |
+|					      		                        |
+| Implementado por: LUIS ARTHUR DE ASSIS MORAES  	    |
+| 					ALEX DE ANDRADE SOARES  	        |
++-------------------------------------------------------+ */
+
+#ifndef PFMAX_H
+#define PFMAX_H
+
+#include <bits/stdc++.h>
+#include "../comum/execucao.h"
+#include "../comum/fluxo_maximo.h"
+#include "../comum/fluxo_paralelo.h"
+
+using namespace std;
+
+namespace pfmax {
+
+//Conjuntos do Problema
+int O; //Quantidade de Vertices
+Grafo g; //Conjunto de caminhos (capacidade em g.cap)
+int n_rotas = 0; //Quantidade de rotas lidas (repeticoes incluidas)
+int D; //id do vertice origem
+int F;	//id do vertice destino
+bool cortar = false; //--cut: lado da origem e arcos saturados do corte minimo no registro
+bool verificar = false; //--check: confere o fluxo devolvido pelo motor (certificado de otimalidade)
+int nThreads = 0; //Threads do motor parallel (0 = todas as disponiveis)
+bool incremental = false; //Modo incremental: capacidades novas em stdin apos a instancia inicial
+
+//Vertices alcancaveis de D no grafo residual do fluxo (em fila, na ordem da busca)
+vector<int> ladoOrigem(const vector<long long>& fluxo, vector<char>& lado){
+	int k, p, v; //Auxiliares
+	vector<int> fila = {D};
+
+	lado.assign(O, 0);
+	lado[D] = 1;
+	for( size_t q = 0; q < fila.size(); q++ ){
+		v = fila[q];
+		for( k = g.inicio[v]; k < g.inicio[v+1]; k++ ){
+			if(!lado[g.destino[k]] && fluxo[k] < g.cap[k]){
+				lado[g.destino[k]] = 1;
+				fila.push_back(g.destino[k]);
+			}
+		}
+		for( p = g.inicioInv[v]; p < g.inicioInv[v+1]; p++ ){
+			k = g.arcoInv[p];
+			if(!lado[g.origem[k]] && fluxo[k] > 0){
+				lado[g.origem[k]] = 1;
+				fila.push_back(g.origem[k]);
+			}
+		}
+	}
+	return fila;
+}
+
+//Corte minimo a partir de um fluxo maximo: o lado da origem sao os vertices alcancaveis de D
+//no grafo residual e os arcos que saem dele estao saturados (gargalos da rede)
+void corteMinimo(const vector<long long>& fluxo){
+	int k; //Auxiliar
+	long long capacidade = 0;
+	vector<char> lado;
+	vector<int> fila = ladoOrigem(fluxo, lado), arcos;
+
+	//Solucao sem prova de otimalidade (limite de tempo do CPLEX): ainda ha caminho aumentante
+	if(lado[F]){
+		saida.anexar("Corte minimo indisponivel: o fluxo encontrado nao e maximo\n", "");
+		return;
+	}
+	for( k = 0; k < g.m; k++ ){
+		if(lado[g.origem[k]] && !lado[g.destino[k]]){
+			arcos.push_back(k);
+			capacidade += g.cap[k];
+		}
+	}
+	sort(fila.begin(), fila.end());
+
+	string texto = "Corte minimo: capacidade " + to_string(capacidade) + " - " + to_string(arcos.size()) + " arcos saturados - " + to_string(fila.size()) + " vertices no lado da origem\n";
+	string json = "\"corte\":{\"capacidade\":" + to_string(capacidade) + ",\"origem\":[";
+	if(!saida.quieto) texto += "Lado da origem:";
+	for( size_t i = 0; i < fila.size(); i++ ){
+		if(!saida.quieto) texto += " " + to_string(fila[i]);
+		json += (i ? "," : "") + to_string(fila[i]);
+	}
+	if(!saida.quieto) texto += "\nArcos saturados:";
+	json += "],\"arcos\":[";
+	for( size_t i = 0; i < arcos.size(); i++ ){
+		k = arcos[i];
+		if(!saida.quieto) texto += " [" + to_string(g.origem[k]) + ", " + to_string(g.destino[k]) + "]";
+		json += string(i ? "," : "") + "[" + to_string(g.origem[k]) + "," + to_string(g.destino[k]) + "]";
+	}
+	if(!saida.quieto) texto += "\n";
+	saida.anexar(texto, json + "]}");
+}
+
+//--check: confere o resultado sem confiar no motor. Capacidades e conservacao valem, o
+//destino recebe exatamente o valor informado e o grafo residual nao tem caminho de D a F
+//(o corte dos alcancaveis tem capacidade igual ao fluxo, o que prova a otimalidade).
+bool verificarFluxo(const vector<long long>& fluxo, long long valor){
+	int k, v; //Auxiliares
+	string erro;
+	vector<long long> saldo(O, 0);
+	vector<char> lado;
+
+	for( k = 0; k < g.m && erro.empty(); k++ ){
+		if(fluxo[k] < 0 || fluxo[k] > g.cap[k]) erro = "arco [" + to_string(g.origem[k]) + ", " + to_string(g.destino[k]) + "] fora da capacidade";
+		saldo[g.origem[k]] -= fluxo[k];
+		saldo[g.destino[k]] += fluxo[k];
+	}
+	for( v = 0; v < O && erro.empty(); v++ ){
+		if(v != D && v != F && saldo[v] != 0) erro = "vertice " + to_string(v) + " nao conserva o fluxo";
+	}
+	if(erro.empty() && D != F && saldo[F] != valor) erro = "o destino recebe " + to_string(saldo[F]) + ", e nao o valor informado";
+	if(erro.empty() && D != F){
+		ladoOrigem(fluxo, lado);
+		if(lado[F]) erro = "ainda ha caminho aumentante";
+	}
+
+	if(erro.empty()) saida.anexar("Verificacao do fluxo: ok\n", "\"verificado\":true");
+	else {
+		saida.anexar("Verificacao do fluxo: FALHOU (" + erro + ")\n", "\"verificado\":false");
+		fprintf(stderr, "Verificacao do fluxo falhou: %s\n", erro.c_str());
+	}
+	return erro.empty();
+}
+
+#ifndef SEM_CPLEX
+//Modelo do CPLEX mantido entre as instancias do modo lote
+IloModel model;
+IloNumVarArray x; //Variaveis de decisao, uma por arco
+IloObjective fo;
+IloCplex solverCplex;
+vector<int> formaModelo; //Forma do modelo montado (vazia: nenhum)
+int numberVar = 0; //Total de Variaveis
+int numberRes = 0; //Total de Restricoes
+
+//O que define a estrutura do modelo: instancias com a mesma forma reaproveitam o modelo
+vector<int> forma(){
+	vector<int> f = {O, D, F};
+	f.insert(f.end(), g.origem.begin(), g.origem.end());
+	f.insert(f.end(), g.destino.begin(), g.destino.end());
+	return f;
+}
+
+void liberarModelo(){
+	if(formaModelo.empty()) return;
+	solverCplex.end();
+	model.end();
+	fo.end();
+	x.endElements();
+	x.end();
+	formaModelo.clear();
+}
+
+//Monta o modelo da instancia atual do zero
+void montarModelo(){
+	int i, k; //Auxiliares
+	numberVar = 0;
+	numberRes = 0;
+
+
+	//---------- MODELAGEM ---------------
+	//Definicao - Variaveis de Decisao (x_ij) não binárias (discretas), uma por arco lido,
+	//com a capacidade como limite superior da variavel
+	x = IloNumVarArray(env);
+	for( k = 0; k < g.m; k++ ){
+		x.add(IloNumVar(env, 0, g.cap[k], relaxacaoLP ? ILOFLOAT : ILOINT));
+		numberVar++;
+	}
+
+	//Definicao do ambiente modelo ------------------------------------------
+	model = IloModel(env);
+	
+	//Definicao do ambiente expressoes, para os somatorios ---------------------------------
+	IloExpr sum(env); /// Expression for Sum
+	IloExpr sum2(env); /// Expression for Sum2
+
+	//FUNCAO OBJETIVO ---------------------------------------------
+	//Saida liquida de D (sai menos entra): o mesmo valor s-t dos motores nativos
+	i = D;
+	sum.clear();
+	for( k = g.inicio[i]; k < g.inicio[i+1]; k++ ){
+		sum += x[k];
+	}
+	for( k = g.inicioInv[i]; k < g.inicioInv[i+1]; k++ ){
+		sum -= x[g.arcoInv[k]];
+	}
+	fo = IloMaximize(env, sum);
+	model.add(fo); //Maximizacao
+
+	//RESTRICOES ---------------------------------------------	
+	 
+	//Restrições de ida e volta
+	for( i = 0; i < O; i++ ){
+		if ((i != D) && (i != F)) {
+			sum.clear();
+			for( k = g.inicio[i]; k < g.inicio[i+1]; k++ ){
+				sum += x[k];
+			}
+			for( k = g.inicioInv[i]; k < g.inicioInv[i+1]; k++ ){
+				sum -= x[g.arcoInv[k]];
+			}
+			model.add(sum == 0); 
+			numberRes++;
+		}
+	}		
+
+	medicao.parar(Medicao::MODELO);
+	solverCplex = IloCplex(model); //extracao do modelo para o CPLEX
+	medicao.parar(Medicao::EXTRACAO);
+	formaModelo = forma();
+
+	sum.end();
+	sum2.end();
+}
+
+//Mesma forma do modelo montado: troca so coeficientes e lados direitos
+void atualizarModelo(){
+	int k; //Auxiliar
+
+	for( k = 0; k < g.m; k++ ) x[k].setUB(g.cap[k]);
+}
+
+void cplex(){
+	//------ EXECUCAO do MODELO ----------
+	IloNum value, objValue;
+	double runTime;
+	string status;
+	bool sol;
+	int k; //Auxiliar
+
+	medicao.comecar();
+	//Instancia com a mesma forma da anterior: so troca coeficientes e lados direitos
+	if(formaModelo == forma()) atualizarModelo();
+	else{
+		liberarModelo();
+		montarModelo();
+	}
+	medicao.parar(Medicao::MODELO);
+	IloCplex cplex = solverCplex;
+	
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("#Var: %d\n", numberVar);
+		printf("#Restricoes: %d\n", numberRes);
+		memoriaCplex("after variable creation");
+	
+		memoriaCplex("after cplex(Model)");
+	}
+
+	status = resolverCplex(cplex, sol);
+
+	if(sol){ 
+
+		//Results
+		//int Nbin, Nint, Ncols, Nrows, Nnodes, Nnodes64;
+		objValue = cplex.getObjValue();
+		runTime = medicao.segundos(Medicao::RESOLUCAO);
+		IloNumArray valores(env);
+		cplex.getValues(valores, x); //todos os valores numa chamada so
+		//Informacoes Adicionais
+		//Nbin = cplex.getNbinVars();
+		//Nint = cplex.getNintVars();
+		//Ncols = cplex.getNcols();
+		//Nrows = cplex.getNrows();
+		//Nnodes = cplex.getNnodes();
+		//Nnodes64 = cplex.getNnodes64();
+		//float gap; gap = cplex.getMIPRelativeGap();
+		
+		vector<long long> fluxo(g.m);
+		for( k = 0; k < g.m; k++ ){
+			value = IloRound(valores[k]);
+			fluxo[k] = value;
+			if(value != 0) saida.variavel(g.origem[k], g.destino[k], value);
+		}
+		valores.end();
+		if(verificar) verificarFluxo(fluxo, llround(objValue));
+		if(cortar) corteMinimo(fluxo);
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(status);
+
+	if(saida.detalhes()) memoriaCplex("before end");
+}
+#endif
+
+FluxoMaximo fm; //Fluxo do motor nativo, mantido entre as atualizacoes do modo incremental
+bool fluxoQuente = false; //O fluxo anterior ja foi reparado (alterarCapacidade): so reotimiza
+
+//Resolve com o push-relabel nativo (--engine=native, ou parallel com --threads=),
+//imprimindo no mesmo formato do cplex()
+void nativo(){
+	int k; //Auxiliar
+	long long value, objValue;
+	double runTime;
+	bool quente = fluxoQuente, interrompido;
+	bool paralelo = motor == "parallel";
+	vector<long long> fluxo(g.m);
+	FluxoParalelo fp;
+
+	fluxoQuente = false;
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		if(paralelo) printf("Motor: push-relabel sincrono (nativo, %d threads)\n", nThreads);
+		else printf("Motor: push-relabel (nativo%s)\n", quente ? ", a partir do fluxo anterior" : "");
+		printf("#Arcos: %d\n", g.m);
+	}
+
+	medicao.comecar();
+	if(paralelo){
+		Equipe equipe(nThreads);
+		fp.parar = &corrida.cancelada;
+		objValue = fp.resolver(g, D, F, equipe);
+		interrompido = fp.interrompido;
+	}
+	else{
+		fm.parar = &corrida.cancelada;
+		objValue = quente ? fm.reotimizar(D, F) : fm.resolver(g, D, F);
+		interrompido = fm.interrompido;
+	}
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+	if(interrompido){
+		saida.emitir("No Solution");
+		return;
+	}
+	if(paralelo && saida.detalhes()) printf("Rodadas: %lld - pushes: %lld - relabels: %lld - reetiquetagens globais: %lld\n", fp.nRodadas, fp.nPush, fp.nRelabel, fp.nGlobal);
+
+	for( k = 0; k < g.m; k++ ){
+		value = fluxo[k] = paralelo ? fp.fluxo(k) : fm.fluxo(k);
+		if(value != 0) saida.variavel(g.origem[k], g.destino[k], value);
+	}
+	if(verificar) verificarFluxo(fluxo, objValue);
+	if(cortar) corteMinimo(fluxo);
+	medicao.parar(Medicao::SOLUCAO);
+	saida.solucao(objValue, runTime);
+	saida.emitir("Optimal");
+}
+
+
+//Le uma instancia (false se a entrada esta vazia ou com erro de formato, informado com a linha)
+bool ler(istream& in, const string& nome){
+	int r[3];
+	Leitor leitor(in, nome);
+	if(leitor.vazio()) return false;
+	if(!leitor.quantidade(O, "a quantidade de vertices") || !leitor.campo(D, "o vertice origem") || !leitor.campo(F, "o vertice destino")) return false;
+	if(!leitor.intervalo(D, O, "origem") || !leitor.intervalo(F, O, "destino")) return false;
+
+	n_rotas = 0;
+	ListaArcos lista;
+
+	//Cada caminho lido vira um arco (o d capacidade por linha); leituras repetidas sobrescrevem o mesmo arco
+	while(leitor.registro(r, 3)) {
+		if(!leitor.intervalo(r[0], O, "vertice") || !leitor.intervalo(r[1], O, "vertice")) return false;
+		lista.add(r[0], r[1], 0, r[2]);
+		n_rotas++;
+	}
+	if(leitor.erro) return false;
+
+	medicao.parar(Medicao::LEITURA);
+	g.montar(O, O, lista);
+	//No modo incremental os arcos sem capacidade ficam, pois podem ganhar capacidade depois
+	if(!incremental) g.removerSemCapacidade();
+	medicao.parar(Medicao::GRAFO);
+	return true;
+}
+
+//Instancia no formato binario (gerada pelo conversor): as colunas de g apontam direto
+//para o arquivo mapeado, sem interpretar os arcos
+bool lerBinario(){
+	if(mapa.problema() != "pfmax" || mapa.cab->nPrefixo < 3) {
+		fprintf(stderr, "Arquivo binario nao e uma instancia do PFMAX (%s)\n", mapa.problema().c_str());
+		return false;
+	}
+	const int* p = mapa.prefixo();
+	O = p[0];
+	D = p[1];
+	F = p[2];
+	if(!mapa.dimensoes(O, O)) return false;
+	if(D < 0 || D >= O || F < 0 || F >= O) {
+		fprintf(stderr, "Arquivo binario corrompido: origem %d ou destino %d fora de 0 a %d\n", D, F, O - 1);
+		return false;
+	}
+	n_rotas = mapa.cab->nRotas;
+	mapa.vista(g);
+	medicao.parar(Medicao::LEITURA);
+	return true;
+}
+
+//Modo incremental: resolve a instancia inicial (primeiro caminho da linha de comando ou
+//bloco de stdin ate "---") e depois le de stdin atualizacoes "o d c", nova capacidade do
+//arco o -> d. Cada linha em branco, e o fim da entrada, re-resolve. O motor nativo repara o
+//fluxo anterior em vez de recomecar; o CPLEX so troca os limites e parte da base anterior.
+void modoIncremental(Problema& p, Lote& lote){
+	int o, d, c, k, rodada = 0;
+	vector<int> alterados;
+	string linha;
+	istream* in = lote.proxima();
+
+	medicao.zerar();
+	//Instancia binaria: o mapeamento e privado, entao as capacidades podem mudar na memoria
+	if(in == nullptr || !(mapa.abrir(lote.caminho()) ? lerBinario() : !mapa.corrompido && ler(*in, lote.nome))) {
+		fprintf(stderr, "Instancia inicial vazia ou incompleta\n");
+		return;
+	}
+	if(saida.texto()) lote.cabecalho();
+	saida.iniciar(lote.nome);
+	resolver(p);
+
+	while(true) {
+		bool fim = !getline(cin, linha);
+		if(!fim && linha.find_first_not_of(" \t\r") != string::npos) {
+			istringstream campos(linha);
+			if(!(campos >> o >> d >> c) || c < 0 || !(campos >> ws).eof()) {
+				fprintf(stderr, "Atualizacao ignorada (esperado: o d c, com c >= 0): %s\n", linha.c_str());
+				continue;
+			}
+			k = (o >= 0 && o < g.n) ? g.arco(o, d) : -1;
+			if(k < 0) {
+				fprintf(stderr, "Arco %d -> %d nao existe na rede: atualizacao ignorada\n", o, d);
+				continue;
+			}
+			if(motor == "native") fm.alterarCapacidade(k, c, D, F);
+			g.cap[k] = c;
+			alterados.push_back(k);
+			continue;
+		}
+
+		if(!alterados.empty()) {
+			sort(alterados.begin(), alterados.end());
+			alterados.erase(unique(alterados.begin(), alterados.end()), alterados.end());
+			rodada++;
+			if(saida.texto()) printf("==== Atualizacao %d: %d arcos alterados ====\n", rodada, (int)alterados.size());
+			saida.iniciar(lote.nome + "#" + to_string(rodada));
+			medicao.zerar();
+			fluxoQuente = motor == "native";
+			resolver(p);
+			alterados.clear();
+		}
+		if(fim) break;
+	}
+}
+
+//Ligacao com o laco comum de instancias (comum/execucao.h)
+struct PFMAX : Problema {
+	PFMAX() : Problema("pfmax", {"native", "parallel"}) {}
+
+	bool argumento(const char* arg) override {
+		if(strcmp(arg, "--cut") == 0) cortar = true;
+		else if(strcmp(arg, "--check") == 0) verificar = true;
+		else if(strcmp(arg, "--incremental") == 0) incremental = true;
+		else if(strncmp(arg, "--threads=", 10) == 0) nThreads = atoi(arg + 10);
+		else return false;
+		return true;
+	}
+	bool validar() override {
+		if(incremental && motor == "portfolio") {
+			fprintf(stderr, "O modo incremental reaproveita o fluxo de um motor so: use --engine=cplex ou --engine=native\n");
+			return false;
+		}
+		if(nThreads <= 0) nThreads = threadsPadrao();
+		return true;
+	}
+
+	bool ler(istream& in, const string& instancia) override { return pfmax::ler(in, instancia); }
+	bool lerBinario() override { return pfmax::lerBinario(); }
+	void eco() override {
+		printf("Verificacao da leitura dos dados:\n");
+		printf("Num. de locais: %d\n", O);
+		printf("Num. de rotas: %d\n", n_rotas);
+		printf("origem: id - destino: id - capacidade\n");
+		for(int k=0; k<g.m; k++) {
+			if(g.cap[k] != 0) printf("origem: %d - destino: %d - capacidade: %d\n", g.origem[k], g.destino[k], g.cap[k]);
+		}
+	}
+	void nativo() override { pfmax::nativo(); }
+#ifndef SEM_CPLEX
+	void cplex() override { pfmax::cplex(); }
+	void liberar() override { liberarModelo(); }
+#endif
+	bool laco(Lote& lote) override {
+		if(!incremental) return false;
+		lote.ativo = true;
+		modoIncremental(*this, lote);
+		return true;
+	}
+};
+
+}
+
+#endif
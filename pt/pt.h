@@ -0,0 +1,272 @@
+/*---------------- File: pt.h  -------------------------+
+|Modelo PLI - Problema do Transporte (PT)               |
+|					      		                        |
+|					      		                        |
+| Implementado por: LUIS ARTHUR DE ASSIS MORAES  	    |
+| 					ALEX DE ANDRADE SOARES  	        |
++-------------------------------------------------------+ */
+
+#ifndef PT_H
+#define PT_H
+
+#include <bits/stdc++.h>
+#include "../comum/execucao.h"
+#include "../comum/transporte.h"
+#ifndef SEM_CPLEX
+#include "../comum/matriz_cplex.h"
+#endif
+
+using namespace std;
+
+namespace pt {
+
+struct vertice {
+    int id, w; //id do vertice e sua necessidade/recurso
+};
+
+//Conjuntos do Problema
+int O; //Quantidade de origens
+vector<vertice> origens; //Conjunto das origens
+vector<vertice> demandas; //Conjunto das demandas
+Grafo g; //Conjunto das arestas (origem -> demanda, custo em g.custo)
+int D; //Quantidade de demandas
+
+#ifndef SEM_CPLEX
+//Modelo do CPLEX mantido entre as instancias do modo lote, carregado em bloco (comum/matriz_cplex.h)
+MatrizCplex matriz;
+vector<int> formaModelo; //Forma do modelo montado (vazia: nenhum)
+int numberVar = 0; //Total de Variaveis
+int numberRes = 0; //Total de Restricoes
+
+//O que define a estrutura do modelo: instancias com a mesma forma reaproveitam o modelo
+vector<int> forma(){
+	return {O, D};
+}
+
+void liberarModelo(){
+	matriz.fechar();
+	formaModelo.clear();
+}
+
+//Custos na ordem das colunas (um por aresta), em paralelo, e lados direitos (demandas e ofertas)
+void preencherCustos(Equipe& equipe){
+	int i; //Auxiliar
+	equipe.paraCada(g.m, [&](int ini, int fim, int){
+		for( int k = ini; k < fim; k++ ) matriz.obj[k] = g.custo[k];
+	});
+	for( i = 0; i < D; i++ ) matriz.rhs[i] = demandas[i].w;
+	for( i = 0; i < O; i++ ) matriz.rhs[D + i] = origens[i].w;
+}
+
+//Monta o modelo da instancia atual do zero: as colunas sao preenchidas em paralelo em
+//vetores planos e o CPLEX recebe a matriz inteira numa chamada (CPXcopylp)
+void montarModelo(){
+	int i; //Auxiliar
+	Equipe equipe(threadsPadrao());
+
+	//---------- MODELAGEM ---------------
+	//Variaveis de Decisao (x_ij) não binárias (discretas), uma por aresta, sem limite superior:
+	//a coluna k entra na restricao da demanda destino[k] e na da origem origem[k]
+	matriz.dimensionar(D + O, g.m, 2, false, equipe);
+	equipe.paraCada(g.m, [&](int ini, int fim, int){
+		for( int k = ini; k < fim; k++ ){
+			matriz.indice[2*k] = g.destino[k];
+			matriz.indice[2*k+1] = D + g.origem[k];
+		}
+	});
+
+	//RESTRICOES: linhas 0..D-1 das demandas (>= demanda) e D..D+O-1 das origens (<= oferta)
+	for( i = 0; i < D + O; i++ ) matriz.sentido[i] = i < D ? 'G' : 'L';
+	preencherCustos(equipe);
+	numberVar = g.m;
+	numberRes = D + O;
+
+	medicao.parar(Medicao::MODELO);
+	if(!matriz.carregar(CPX_MIN, !relaxacaoLP)) matriz.liberar();
+	medicao.parar(Medicao::EXTRACAO);
+	formaModelo = matriz.lp != nullptr ? forma() : vector<int>();
+}
+
+//Mesma forma do modelo montado: troca so custos e lados direitos
+void atualizarModelo(){
+	Equipe equipe(threadsPadrao());
+	preencherCustos(equipe);
+	if(!matriz.atualizar()) liberarModelo();
+}
+
+void cplex(){
+	//------ EXECUCAO do MODELO ----------
+	double objValue, runTime;
+	string status;
+	bool sol = false;
+	vector<double> valores;
+	int k; //Auxiliar
+
+	medicao.comecar();
+	//Instancia com a mesma forma da anterior: so troca custos e lados direitos
+	if(formaModelo == forma()) atualizarModelo();
+	else{
+		liberarModelo();
+		montarModelo();
+	}
+	medicao.parar(Medicao::MODELO);
+	
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("#Var: %d\n", numberVar);
+		printf("#Restricoes: %d\n", numberRes);
+		cout << "Memory usage after CPXcopylp:  pico RSS " << Medicao::mb(Medicao::picoRSS()) << " MB" << endl;
+	}
+
+	if(matriz.lp == nullptr) status = "No Solution";
+	else{
+		matriz.terminar = &corrida.terminar;
+		medicao.comecar();
+		status = matriz.resolver(parametrosCplex, saida.detalhes(), sol, objValue, valores);
+		medicao.parar(Medicao::RESOLUCAO);
+	}
+
+	if(sol){ 
+		runTime = medicao.segundos(Medicao::RESOLUCAO);
+		for( k = 0; k < g.m; k++ ){
+			if(IloRound(valores[k]) != 0) saida.variavel(g.origem[k], g.destino[k], IloRound(valores[k]));
+		}
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(status);
+}
+#endif
+
+//Resolve com o simplex de transporte nativo, imprimindo no mesmo formato do cplex()
+void nativo(){
+	int i, e; //Auxiliares
+	long long objValue;
+	double runTime;
+	vector<long long> a(O), b(D);
+	Transporte tr;
+
+	if(!Transporte::custosValidos(g)){
+		fprintf(stderr, "Simplex de transporte exige custos nao negativos: use --engine=cplex\n");
+		saida.emitir("No Solution");
+		return;
+	}
+	for( i = 0; i < O; i++ ) a[i] = origens[i].w;
+	for( i = 0; i < D; i++ ) b[i] = demandas[i].w;
+	medicao.comecar();
+	tr.carregar(g, a, b);
+	medicao.parar(Medicao::MODELO);
+
+	//Informacoes ---------------------------------------------	
+	if(saida.detalhes()){
+		printf("--------Informacoes da Execucao:----------\n\n");
+		printf("Motor: simplex de transporte, Vogel + MODI (nativo)\n");
+		printf("#Var: %d\n", g.m);
+	}
+
+	medicao.comecar();
+	bool sol = (tr.resolver() == Transporte::OTIMO);
+	medicao.parar(Medicao::RESOLUCAO);
+	runTime = medicao.segundos(Medicao::RESOLUCAO);
+
+	if(sol){
+		objValue = tr.custoTotal();
+		vector<int> envios = tr.envios();
+		for( i = 0; i < (int)envios.size(); i++ ){
+			e = envios[i];
+			saida.variavel(tr.celI[e], tr.celJ[e], tr.celX[e]);
+		}
+		medicao.parar(Medicao::SOLUCAO);
+		saida.solucao(objValue, runTime);
+	}
+	saida.emitir(sol ? "Optimal" : "No Solution");
+}
+
+
+//Le uma instancia (false se a entrada esta vazia ou com erro de formato, informado com a linha)
+bool ler(istream& in, const string& nome){
+	int i, r[3];
+	Leitor leitor(in, nome);
+	if(leitor.vazio()) return false;
+	if(!leitor.quantidade(O, "a quantidade de origens") || !leitor.quantidade(D, "a quantidade de demandas")) return false;
+
+	origens.assign(O, vertice());
+	demandas.assign(D, vertice());
+	ListaArcos lista;
+
+	//Todas as rotas existem; as nao informadas tem custo 0
+	for(i=0; i<O; i++) {
+		for(int l=0; l<D; l++) {
+			lista.add(i, l, 0, 0);
+		}	
+	}
+
+	for(i=0; i<O; i++){
+		if(!leitor.campo(origens[i].w, "a oferta das origens")) return false;
+	} 
+	for(i=0; i<D; i++){
+		if(!leitor.campo(demandas[i].w, "as demandas")) return false;
+	}
+	while(leitor.registro(r, 3)) {
+		if(!leitor.intervalo(r[0], O, "origem") || !leitor.intervalo(r[1], D, "demanda")) return false;
+		lista.add(r[0], r[1], r[2], 0);
+	}
+	if(leitor.erro) return false;
+
+	medicao.parar(Medicao::LEITURA);
+	g.montar(O, D, lista);
+	medicao.parar(Medicao::GRAFO);
+	return true;
+}
+
+//Instancia no formato binario (gerada pelo conversor): as colunas de g apontam direto
+//para o arquivo mapeado, sem interpretar os arcos
+bool lerBinario(){
+	int i;
+	if(mapa.problema() != "pt" || mapa.cab->nPrefixo < 2) {
+		fprintf(stderr, "Arquivo binario nao e uma instancia do PT (%s)\n", mapa.problema().c_str());
+		return false;
+	}
+	const int* p = mapa.prefixo();
+	O = p[0];
+	D = p[1];
+	if(!mapa.dimensoes(O, D)) return false;
+	if(mapa.cab->nPrefixo != 2 + (int64_t)O + D) {
+		fprintf(stderr, "Arquivo binario corrompido: esperadas %d ofertas e %d demandas no prefixo\n", O, D);
+		return false;
+	}
+	origens.assign(O, vertice());
+	demandas.assign(D, vertice());
+	for(i=0; i<O; i++) origens[i].w = p[2 + i];
+	for(i=0; i<D; i++) demandas[i].w = p[2 + O + i];
+	mapa.vista(g);
+	medicao.parar(Medicao::LEITURA);
+	return true;
+}
+
+//Ligacao com o laco comum de instancias (comum/execucao.h)
+struct PT : Problema {
+	PT() : Problema("pt", {"native"}) {}
+
+	bool ler(istream& in, const string& instancia) override { return pt::ler(in, instancia); }
+	bool lerBinario() override { return pt::lerBinario(); }
+	void eco() override {
+		printf("Verificacao da leitura dos dados:\n");
+		printf("Num. de origens: %d\n", O);
+		printf("Num. de demandas: %d\n", D);
+		printf("Local: id - Destino: id - Capacidade\n");
+		for(int k=0; k<g.m; k++) {
+			if(g.custo[k] != 0) printf("origem: %d - destino: %d - capacidade: %d\n", g.origem[k], g.destino[k], g.custo[k]);
+		}
+	}
+	void nativo() override { pt::nativo(); }
+#ifndef SEM_CPLEX
+	void cplex() override { pt::cplex(); }
+	void liberar() override { liberarModelo(); }
+#endif
+};
+
+}
+
+#endif
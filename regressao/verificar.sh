@@ -0,0 +1,74 @@
+#!/bin/bash
+#---------------- File: verificar.sh -----------------------
+# Regressao dos motores nativos: roda cada motor e modo de cada problema nas
+# instancias pequenas de instancias/ (e nos in.txt de cada problema) e compara
+# instancia, status e FO de cada registro com os valores guardados em esperado.txt.
+# No pfmax, --check confere tambem o fluxo devolvido (conservacao e capacidades)
+# e o corte minimo de --cut tem de ter a mesma capacidade que a FO.
+#
+# Uso: ./verificar.sh               (diff contra esperado.txt; sai com 1 se algo mudou)
+#      ./verificar.sh --atualizar   (regrava esperado.txt depois de uma mudanca intencional)
+#-----------------------------------------------------------
+
+cd "$(dirname "$0")"
+
+I=instancias
+ESPERADO=esperado.txt
+
+#Nome do caso e comando; os registros saem em JSON lines
+CASOS=(
+	"pcm_binary|../pcm/main_nativo.exe --engine=native --heap=binary ../pcm/in.txt $I/pcm_random.txt $I/pcm_grid.txt"
+	"pcm_radix|../pcm/main_nativo.exe --engine=native --heap=radix ../pcm/in.txt $I/pcm_random.txt $I/pcm_grid.txt"
+	"pcm_bidirecional|../pcm/main_nativo.exe --engine=native --bidirectional ../pcm/in.txt $I/pcm_random.txt $I/pcm_grid.txt"
+	"pcm_bidirecional_radix|../pcm/main_nativo.exe --engine=native --bidirectional --heap=radix $I/pcm_random.txt $I/pcm_grid.txt"
+	"pcm_consultas|../pcm/main_nativo.exe --queries=$I/pcm_consultas.txt --threads=2 $I/pcm_grid.txt"
+	"pcm_portfolio|../pcm/main_nativo.exe --engine=portfolio ../pcm/in.txt $I/pcm_random.txt $I/pcm_grid.txt"
+	"pd_hungaro|../pd/main_nativo.exe --engine=native ../pd/in.txt $I/pd_random.txt $I/pd_grid.txt"
+	"pd_leilao|../pd/main_nativo.exe --engine=auction --threads=2 ../pd/in.txt $I/pd_random.txt $I/pd_grid.txt"
+	"pd_esparso|../pd/main_nativo.exe --engine=native --sparse $I/pd_esparso.txt"
+	"pd_gargalo|../pd/main_nativo.exe --engine=native --bottleneck ../pd/in.txt $I/pd_random.txt"
+	"pd_k_melhores|../pd/main_nativo.exe --engine=native --k-best=3 ../pd/in.txt $I/pd_random.txt"
+	"pd_portfolio|../pd/main_nativo.exe --engine=portfolio ../pd/in.txt $I/pd_random.txt $I/pd_grid.txt"
+	"pfcm_simplex|../pfcm/main_nativo.exe --engine=native ../pfcm/in.txt $I/pfcm_random.txt $I/pfcm_grid.txt"
+	"pfcm_multiproduto|../pfcm/main_nativo.exe --commodities=$I/pfcm_produtos.txt $I/pfcm_grid.txt"
+	"pfcm_incremental|../pfcm/main_nativo.exe --engine=native --incremental $I/pfcm_grid.txt < $I/pfcm_atualizacoes.txt"
+	"pfcm_portfolio|../pfcm/main_nativo.exe --engine=portfolio ../pfcm/in.txt $I/pfcm_random.txt $I/pfcm_grid.txt"
+	"pfmax_push_relabel|../pfmax/main_nativo.exe --engine=native --check ../pfmax/in.txt $I/pfmax_random.txt $I/pfmax_grid.txt"
+	"pfmax_paralelo|../pfmax/main_nativo.exe --engine=parallel --threads=4 --check ../pfmax/in.txt $I/pfmax_random.txt $I/pfmax_grid.txt"
+	"pfmax_corte|../pfmax/main_nativo.exe --engine=native --cut ../pfmax/in.txt $I/pfmax_grid.txt"
+	"pfmax_incremental|../pfmax/main_nativo.exe --engine=native --check --incremental $I/pfmax_grid.txt < $I/pfmax_atualizacoes.txt"
+	"pfmax_incremental_paralelo|../pfmax/main_nativo.exe --engine=parallel --threads=2 --check --incremental $I/pfmax_grid.txt < $I/pfmax_atualizacoes.txt"
+	"pfmax_portfolio|../pfmax/main_nativo.exe --engine=portfolio ../pfmax/in.txt $I/pfmax_random.txt $I/pfmax_grid.txt"
+	"pt_simplex|../pt/main_nativo.exe --engine=native ../pt/in.txt $I/pt_random.txt $I/pt_grid.txt"
+	"pt_portfolio|../pt/main_nativo.exe --engine=portfolio ../pt/in.txt $I/pt_random.txt $I/pt_grid.txt"
+)
+for p in pcm pd pfcm pfmax pt; do CASOS+=("solve_$p|../solve/solve_nativo.exe --problem=$p --engine=native ../$p/in.txt"); done
+
+OBTIDO=$(mktemp)
+trap 'rm -f "$OBTIDO"' EXIT
+
+for caso in "${CASOS[@]}"; do
+	nome=${caso%%|*}
+	cmd=${caso#*|}
+	#Sem as variaveis (x) e o tempo: fica instancia, status, FO e os campos de cada modo
+	saida=$(eval "$cmd --output=jsonl --quiet" 2>&1)
+	rc=$?
+	echo "$saida" | sed -E 's/,"x":\[(\[[^]]*\],?)*\]//; s/,"tempo":[^,}]*//; s/^/'"$nome"' /' >> "$OBTIDO"
+	[ $rc -eq 0 ] || echo "$nome saiu com $rc" >> "$OBTIDO"
+done
+
+#O corte minimo tem a capacidade do fluxo maximo
+awk '/^pfmax_corte /{ f = $0; c = $0; sub(/.*"fo":/, "", f); sub(/.*"capacidade":/, "", c); if(f + 0 != c + 0) print "pfmax_corte com capacidade " c + 0 " e FO " f + 0 }' "$OBTIDO" >> "$OBTIDO"
+
+if [ "$1" = "--atualizar" ]; then
+	cp "$OBTIDO" "$ESPERADO"
+	echo "$ESPERADO regravado ($(wc -l < "$ESPERADO") registros)"
+	exit 0
+fi
+
+if diff -u "$ESPERADO" "$OBTIDO"; then
+	echo "ok: ${#CASOS[@]} casos, $(wc -l < "$ESPERADO") registros iguais a $ESPERADO"
+else
+	echo "Resultados diferentes de $ESPERADO"
+	exit 1
+fi
@@ -0,0 +1,40 @@
+/*---------------- File: main.cpp  ---------------------+
+|Executavel unico dos cinco problemas                    |
+|					      		                        |
+| Uso: solve.exe --problem=pfmax [opcoes do problema]    |
+| As demais opcoes e a entrada sao as mesmas do main.exe |
+| de cada diretorio (comum/execucao.h).                  |
++-------------------------------------------------------+ */
+
+#include <bits/stdc++.h>
+#include "../pcm/pcm.h"
+#include "../pd/pd.h"
+#include "../pfcm/pfcm.h"
+#include "../pfmax/pfmax.h"
+#include "../pt/pt.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+
+	string nome;
+	unique_ptr<Problema> problema;
+
+	for(int a=1; a<argc; a++) {
+		if(strncmp(argv[a], "--problem=", 10) == 0) nome = argv[a] + 10;
+	}
+	if(nome == "pcm") problema.reset(new pcm::PCM());
+	else if(nome == "pd") problema.reset(new pd::PD());
+	else if(nome == "pfcm") problema.reset(new pfcm::PFCM());
+	else if(nome == "pfmax") problema.reset(new pfmax::PFMAX());
+	else if(nome == "pt") problema.reset(new pt::PT());
+	else {
+		fprintf(stderr, "Uso: %s --problem=pcm|pd|pfcm|pfmax|pt [opcoes] [instancias]\n", argv[0]);
+		return 1;
+	}
+
+	int r = executar(*problema, argc, argv);
+	encerrar();
+
+    return r;
+}